@@ -1,6 +1,6 @@
 /**
  * @file benchmark_join.cpp
- * @brief Comprehensive benchmarks for join() function
+ * @brief Comprehensive benchmarks for join() function, joinView() and StringBuilder
  */
 
 #include <benchmark/benchmark.h>
@@ -68,6 +68,126 @@ BENCHMARK(Join_Scaling)
     ->Range(8, 8<<10)
     ->Complexity(benchmark::oN);
 
+// The growth pattern join() used before sizing its output up front - for comparison
+static void Join_Scaling_RepeatedAppend(benchmark::State& state) {
+    size_t num_elements = state.range(0);
+
+    std::vector<std::string> vec;
+    vec.reserve(num_elements);
+    for(size_t i = 0; i < num_elements; ++i) {
+        vec.push_back("element" + std::to_string(i));
+    }
+
+    for (auto _ : state) {
+        std::string result;
+        for(size_t i = 0; i < vec.size(); ++i) {
+            if(i > 0) result += ",";
+            result += vec[i];
+        }
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.SetComplexityN(num_elements);
+    state.SetItemsProcessed(state.iterations() * num_elements);
+}
+BENCHMARK(Join_Scaling_RepeatedAppend)
+    ->RangeMultiplier(2)
+    ->Range(8, 8<<10)
+    ->Complexity(benchmark::oN);
+
+static void Join_Scaling_Views(benchmark::State& state) {
+    size_t num_elements = state.range(0);
+
+    std::vector<std::string> storage;
+    storage.reserve(num_elements);
+    for(size_t i = 0; i < num_elements; ++i) {
+        storage.push_back("element" + std::to_string(i));
+    }
+    std::vector<std::string_view> vec(storage.begin(), storage.end());
+
+    for (auto _ : state) {
+        auto result = stevensStringLib::join(vec, ",");
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.SetComplexityN(num_elements);
+    state.SetItemsProcessed(state.iterations() * num_elements);
+}
+BENCHMARK(Join_Scaling_Views)
+    ->RangeMultiplier(2)
+    ->Range(8, 8<<10)
+    ->Complexity(benchmark::oN);
+
+// ============================================================================
+// LARGE VECTORS - Serial vs parallel join of millions of tokens
+// ============================================================================
+
+static std::vector<std::string> MakeTokens(size_t count) {
+    std::vector<std::string> tokens;
+    tokens.reserve(count);
+    for(size_t i = 0; i < count; ++i) {
+        tokens.push_back((i % 7 == 0) ? "" : "token" + std::to_string(i));
+    }
+    return tokens;
+}
+
+static void Join_LargeVector_Serial(benchmark::State& state) {
+    const std::vector<std::string> tokens = MakeTokens(4000000);
+
+    for (auto _ : state) {
+        auto result = stevensStringLib::join(tokens, ",");
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * tokens.size());
+}
+BENCHMARK(Join_LargeVector_Serial)->Unit(benchmark::kMillisecond);
+
+static void Join_LargeVector_Parallel(benchmark::State& state) {
+    const std::vector<std::string> tokens = MakeTokens(4000000);
+
+    for (auto _ : state) {
+        auto result = stevensStringLib::join(tokens, ",", true, stevensStringLib::ParallelSettings{});
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * tokens.size());
+}
+BENCHMARK(Join_LargeVector_Parallel)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// ============================================================================
+// STREAMING - join() into a string then streamed vs a lazy joinView()
+// ============================================================================
+
+// Discards everything written to it, so only the cost of producing the output is measured
+class NullBuffer : public std::streambuf {
+protected:
+    std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+    int overflow(int ch) override { return ch; }
+};
+
+static void Join_Stream_Materialized(benchmark::State& state) {
+    const std::vector<std::string> tokens = MakeTokens(100000);
+    NullBuffer buffer;
+    std::ostream out(&buffer);
+
+    for (auto _ : state) {
+        out << stevensStringLib::join(tokens, ",");
+    }
+    state.SetItemsProcessed(state.iterations() * tokens.size());
+}
+BENCHMARK(Join_Stream_Materialized)->Unit(benchmark::kMicrosecond);
+
+static void Join_Stream_JoinView(benchmark::State& state) {
+    const std::vector<std::string> tokens = MakeTokens(100000);
+    NullBuffer buffer;
+    std::ostream out(&buffer);
+
+    for (auto _ : state) {
+        out << stevensStringLib::joinView(tokens, ",");
+    }
+    state.SetItemsProcessed(state.iterations() * tokens.size());
+}
+BENCHMARK(Join_Stream_JoinView)->Unit(benchmark::kMicrosecond);
+
 // ============================================================================
 // WORST CASE - Many empty strings
 // ============================================================================
@@ -126,6 +246,77 @@ static void Join_CSV_RealWorld(benchmark::State& state) {
 }
 BENCHMARK(Join_CSV_RealWorld);
 
+// Many rows appended to one reused buffer instead of a new string per row
+static void Join_CSV_IntoReusedBuffer(benchmark::State& state) {
+    std::vector<std::string> record = {
+        "John", "Doe", "john.doe@email.com", "555-1234",
+        "123 Main St", "New York", "NY", "10001"
+    };
+    std::string body;
+
+    for (auto _ : state) {
+        body.clear();
+        for (int row = 0; row < 100; ++row) {
+            stevensStringLib::joinInto(record, ",", body);
+            body += '\n';
+        }
+        benchmark::DoNotOptimize(body);
+    }
+}
+BENCHMARK(Join_CSV_IntoReusedBuffer);
+
+static void Join_CSV_ConcatenatedTemporaries(benchmark::State& state) {
+    std::vector<std::string> record = {
+        "John", "Doe", "john.doe@email.com", "555-1234",
+        "123 Main St", "New York", "NY", "10001"
+    };
+
+    for (auto _ : state) {
+        std::string body;
+        for (int row = 0; row < 100; ++row) {
+            body += stevensStringLib::join(record, ",") + "\n";
+        }
+        benchmark::DoNotOptimize(body);
+    }
+}
+BENCHMARK(Join_CSV_ConcatenatedTemporaries);
+
+// ============================================================================
+// STRING BUILDING - csvAppend() onto a std::string vs a StringBuilder
+// ============================================================================
+
+static void Build_CsvAppend_String(benchmark::State& state) {
+    for (auto _ : state) {
+        std::string csvs;
+        for (int i = 0; i < 1000; ++i) {
+            stevensStringLib::csvAppend(csvs, std::to_string(i));
+        }
+        benchmark::DoNotOptimize(csvs);
+    }
+}
+BENCHMARK(Build_CsvAppend_String);
+
+static void Build_CsvAppend_StringBuilder(benchmark::State& state) {
+    for (auto _ : state) {
+        stevensStringLib::StringBuilder csvs;
+        for (int i = 0; i < 1000; ++i) {
+            if (!csvs.empty()) csvs.append(',');
+            csvs.appendNumber(i);
+        }
+        std::string result = std::move(csvs).str();
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(Build_CsvAppend_StringBuilder);
+
+static void Build_Multiply(benchmark::State& state) {
+    for (auto _ : state) {
+        auto result = stevensStringLib::multiply("ab", static_cast<int>(state.range(0)));
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(Build_Multiply)->Arg(8)->Arg(8<<10);
+
 // ============================================================================
 // ROUNDTRIP - separate then join
 // ============================================================================
@@ -0,0 +1,292 @@
+/**
+ * @file benchmark_search.cpp
+ * @brief Benchmarks for findAll() and the other searching functions
+ *
+ * Compares collecting every hit into a vector against visiting or just counting them, and one
+ * findAll() pass per keyword against a single MultiPatternMatcher pass, and serial against
+ * parallel findAll() over a large buffer, nested contains() loops against batch contains, and
+ * toLower() copies against case-insensitive searching, and full scans against a SubstringIndex,
+ * SuffixArray and FMIndex
+ */
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+#include "../../stevensStringLib.h"
+
+static std::string MakeCsvText(size_t rows) {
+    std::string text;
+    for (size_t i = 0; i < rows; ++i) {
+        text += "John,Doe,john.doe@email.com,555-1234,123 Main St,New York,NY,10001\n";
+    }
+    return text;
+}
+
+// ============================================================================
+// COUNTING - How many hits, without needing their positions
+// ============================================================================
+
+static void Search_CountChar_FindAllSize(benchmark::State& state) {
+    const std::string text = MakeCsvText(state.range(0));
+
+    for (auto _ : state) {
+        size_t count = stevensStringLib::findAll(text, ',').size();
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(Search_CountChar_FindAllSize)->Arg(1000);
+
+static void Search_CountChar_CountAll(benchmark::State& state) {
+    const std::string text = MakeCsvText(state.range(0));
+
+    for (auto _ : state) {
+        size_t count = stevensStringLib::countAll(text, ',');
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(Search_CountChar_CountAll)->Arg(1000);
+
+static void Search_CountSubstring_FindAllSize(benchmark::State& state) {
+    const std::string text = MakeCsvText(state.range(0));
+
+    for (auto _ : state) {
+        size_t count = stevensStringLib::findAll(text, std::string("New York")).size();
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(Search_CountSubstring_FindAllSize)->Arg(1000);
+
+static void Search_CountSubstring_CountAll(benchmark::State& state) {
+    const std::string text = MakeCsvText(state.range(0));
+
+    for (auto _ : state) {
+        size_t count = stevensStringLib::countAll(text, "New York");
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(Search_CountSubstring_CountAll)->Arg(1000);
+
+// ============================================================================
+// EARLY EXIT - Only the first few hits of a long text
+// ============================================================================
+
+static void Search_FirstHits_FindAll(benchmark::State& state) {
+    const std::string text = MakeCsvText(1000);
+
+    for (auto _ : state) {
+        auto positions = stevensStringLib::findAll(text, '\n');
+        size_t thirdLineStart = positions[1] + 1;
+        benchmark::DoNotOptimize(thirdLineStart);
+    }
+}
+BENCHMARK(Search_FirstHits_FindAll);
+
+static void Search_FirstHits_ForEachOccurrence(benchmark::State& state) {
+    const std::string text = MakeCsvText(1000);
+
+    for (auto _ : state) {
+        size_t seen = 0, thirdLineStart = 0;
+        stevensStringLib::forEachOccurrence(text, '\n', [&](size_t index) {
+            thirdLineStart = index + 1;
+            return ++seen < 2;
+        });
+        benchmark::DoNotOptimize(thirdLineStart);
+    }
+}
+BENCHMARK(Search_FirstHits_ForEachOccurrence);
+
+// ============================================================================
+// MULTI-PATTERN - Many keywords over the same text
+// ============================================================================
+
+static std::vector<std::string> MakeKeywords(size_t count) {
+    std::vector<std::string> keywords;
+    for (size_t i = 0; i < count; ++i) {
+        keywords.push_back("key" + std::to_string(i) + "word");
+    }
+    keywords.push_back("New York");
+    return keywords;
+}
+
+static void Search_ManyPatterns_FindAllPerPattern(benchmark::State& state) {
+    const std::string text = MakeCsvText(1000);
+    const std::vector<std::string> keywords = MakeKeywords(state.range(0));
+
+    for (auto _ : state) {
+        size_t hits = 0;
+        for (const std::string& keyword : keywords) {
+            hits += stevensStringLib::findAll(text, keyword).size();
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(Search_ManyPatterns_FindAllPerPattern)->Arg(10)->Arg(100)->Arg(2000);
+
+static void Search_ManyPatterns_MultiPatternMatcher(benchmark::State& state) {
+    const std::string text = MakeCsvText(1000);
+    const stevensStringLib::MultiPatternMatcher matcher(MakeKeywords(state.range(0)));
+
+    for (auto _ : state) {
+        size_t hits = stevensStringLib::findAll(text, matcher).size();
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(Search_ManyPatterns_MultiPatternMatcher)->Arg(10)->Arg(100)->Arg(2000);
+
+// ============================================================================
+// PARALLEL - One needle over a very large buffer
+// ============================================================================
+
+static void Search_LargeBuffer_FindAll(benchmark::State& state) {
+    const std::string text = MakeCsvText(200000);
+
+    for (auto _ : state) {
+        auto positions = stevensStringLib::findAll(text, std::string("New York"), false);
+        benchmark::DoNotOptimize(positions);
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(Search_LargeBuffer_FindAll)->Unit(benchmark::kMillisecond);
+
+static void Search_LargeBuffer_FindAllParallel(benchmark::State& state) {
+    const std::string text = MakeCsvText(200000);
+
+    for (auto _ : state) {
+        auto positions = stevensStringLib::findAll(text, "New York", false, stevensStringLib::ParallelSettings{});
+        benchmark::DoNotOptimize(positions);
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(Search_LargeBuffer_FindAllParallel)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// ============================================================================
+// BATCH CONTAINS - Every row of a table against a filter's keywords
+// ============================================================================
+
+static std::vector<std::string> MakeCsvRows(size_t rows) {
+    std::vector<std::string> result;
+    for (size_t i = 0; i < rows; ++i) {
+        result.push_back("John,Doe,john.doe" + std::to_string(i) + "@email.com,555-1234,123 Main St,New York,NY,10001");
+    }
+    return result;
+}
+
+static void Search_FilterRows_NestedContains(benchmark::State& state) {
+    const std::vector<std::string> rows = MakeCsvRows(1000);
+    const std::vector<std::string> keywords = MakeKeywords(state.range(0));
+
+    for (auto _ : state) {
+        size_t matching = 0;
+        for (const std::string& row : rows) {
+            for (const std::string& keyword : keywords) {
+                if (stevensStringLib::contains(row, keyword)) {
+                    ++matching;
+                    break;
+                }
+            }
+        }
+        benchmark::DoNotOptimize(matching);
+    }
+}
+BENCHMARK(Search_FilterRows_NestedContains)->Arg(10)->Arg(100);
+
+static void Search_FilterRows_WhichContain(benchmark::State& state) {
+    const std::vector<std::string> rows = MakeCsvRows(1000);
+    const stevensStringLib::MultiPatternMatcher keywords(MakeKeywords(state.range(0)));
+
+    for (auto _ : state) {
+        auto matching = stevensStringLib::whichContain(rows, keywords);
+        benchmark::DoNotOptimize(matching);
+    }
+}
+BENCHMARK(Search_FilterRows_WhichContain)->Arg(10)->Arg(100);
+
+// ============================================================================
+// IGNORING CASE - toLower() copies vs folding on the fly
+// ============================================================================
+
+static void Search_IgnoreCase_ToLowerCopies(benchmark::State& state) {
+    const std::string text = MakeCsvText(state.range(0));
+
+    for (auto _ : state) {
+        bool found = stevensStringLib::contains(stevensStringLib::toLower(text), stevensStringLib::toLower("NEW YORK,NJ"));
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(Search_IgnoreCase_ToLowerCopies)->Arg(1)->Arg(1000);
+
+static void Search_IgnoreCase_ContainsIgnoreCase(benchmark::State& state) {
+    const std::string text = MakeCsvText(state.range(0));
+
+    for (auto _ : state) {
+        bool found = stevensStringLib::containsIgnoreCase(text, "NEW YORK,NJ");
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(Search_IgnoreCase_ContainsIgnoreCase)->Arg(1)->Arg(1000);
+
+// ============================================================================
+// REPEATED QUERIES - Scanning the whole text vs the text indexes
+// ============================================================================
+
+static void Search_RepeatedQueries_FindAll(benchmark::State& state) {
+    const std::string text = MakeCsvText(20000) + "needle in a haystack";
+
+    for (auto _ : state) {
+        auto positions = stevensStringLib::findAll(text, std::string("needle in"));
+        benchmark::DoNotOptimize(positions);
+    }
+}
+BENCHMARK(Search_RepeatedQueries_FindAll)->Unit(benchmark::kMicrosecond);
+
+static void Search_RepeatedQueries_SubstringIndex(benchmark::State& state) {
+    const std::string text = MakeCsvText(20000) + "needle in a haystack";
+    const stevensStringLib::SubstringIndex index(text);
+
+    for (auto _ : state) {
+        auto positions = index.findAll("needle in");
+        benchmark::DoNotOptimize(positions);
+    }
+}
+BENCHMARK(Search_RepeatedQueries_SubstringIndex)->Unit(benchmark::kMicrosecond);
+
+static void Search_RepeatedQueries_SuffixArray(benchmark::State& state) {
+    const std::string text = MakeCsvText(20000) + "needle in a haystack";
+    const stevensStringLib::SuffixArray suffixArray(text);
+
+    for (auto _ : state) {
+        auto positions = suffixArray.findAll("needle in");
+        benchmark::DoNotOptimize(positions);
+    }
+}
+BENCHMARK(Search_RepeatedQueries_SuffixArray)->Unit(benchmark::kMicrosecond);
+
+static void Search_RepeatedQueries_FMIndex(benchmark::State& state) {
+    const std::string text = MakeCsvText(20000) + "needle in a haystack";
+    const stevensStringLib::FMIndex index(text);
+
+    for (auto _ : state) {
+        auto positions = index.findAll("needle in");
+        benchmark::DoNotOptimize(positions);
+    }
+}
+BENCHMARK(Search_RepeatedQueries_FMIndex)->Unit(benchmark::kMicrosecond);
+
+static void Search_RepeatedQueries_FMIndexCount(benchmark::State& state) {
+    const std::string text = MakeCsvText(20000) + "needle in a haystack";
+    const stevensStringLib::FMIndex index(text);
+
+    for (auto _ : state) {
+        size_t count = index.countAll(",NY,");
+        benchmark::DoNotOptimize(count);
+    }
+}
+BENCHMARK(Search_RepeatedQueries_FMIndexCount)->Unit(benchmark::kMicrosecond);
@@ -6,10 +6,39 @@
  */
 
 #include <benchmark/benchmark.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
 #include <sstream>
 #include <string>
 #include "../../stevensStringLib.h"
 
+// ============================================================================
+// ALLOCATION COUNTING - global operator new replacement
+// ============================================================================
+
+// Counts every heap allocation made through operator new in this benchmark binary, so benchmarks
+// can report allocations per iteration alongside time (see Separate_CSV_RealWorld*).
+static std::atomic<size_t> g_allocationCount{0};
+
+void* operator new(std::size_t size) {
+    g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) return ptr;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return ::operator new(size); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+static void ReportAllocationsPerIteration(benchmark::State& state, size_t allocationsBefore) {
+    state.counters["allocs_per_iter"] = benchmark::Counter(
+        static_cast<double>(g_allocationCount.load(std::memory_order_relaxed) - allocationsBefore),
+        benchmark::Counter::kAvgIterations);
+}
+
 // ============================================================================
 // BASELINE BENCHMARKS - Compare against standard library
 // ============================================================================
@@ -50,6 +79,27 @@ static void Separate_Baseline_ManualFind(benchmark::State& state) {
 }
 BENCHMARK(Separate_Baseline_ManualFind);
 
+// The find()-per-separator loop plus std::remove() pass that separate(str, char) used before its
+// SIMD scanning kernel - kept here so the scaling/worst-case benchmarks can show the difference.
+static std::vector<std::string> Separate_FindLoop(std::string_view str, char sep, bool omitEmptyStrings) {
+    std::vector<std::string> result;
+    if (str.empty()) return result;
+    size_t start = 0;
+    while (true) {
+        size_t pos = str.find(sep, start);
+        if (pos == std::string_view::npos) {
+            result.emplace_back(str.substr(start));
+            break;
+        }
+        result.emplace_back(str.substr(start, pos - start));
+        start = pos + 1;
+    }
+    if (omitEmptyStrings) {
+        result.erase(std::remove(result.begin(), result.end(), ""), result.end());
+    }
+    return result;
+}
+
 // ============================================================================
 // LIBRARY BENCHMARKS - Char separator
 // ============================================================================
@@ -78,6 +128,152 @@ static void Separate_Library_String(benchmark::State& state) {
 }
 BENCHMARK(Separate_Library_String);
 
+// Compile-time separators vs the same separators passed at runtime, on a long input
+static std::string MakeScopedNames(size_t names) {
+    std::string input;
+    for (size_t i = 0; i < names; ++i) input += "namespace" + std::to_string(i % 97) + "::";
+    return input;
+}
+
+static void Separate_Runtime_Char(benchmark::State& state) {
+    const std::string input = MakeScopedNames(state.range(0));
+
+    for (auto _ : state) {
+        auto result = stevensStringLib::separate(input, ':');
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(Separate_Runtime_Char)->Arg(1000);
+
+static void Separate_Fixed_Char(benchmark::State& state) {
+    const std::string input = MakeScopedNames(state.range(0));
+
+    for (auto _ : state) {
+        auto result = stevensStringLib::separate<':'>(input);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(Separate_Fixed_Char)->Arg(1000);
+
+static void Separate_Runtime_TwoChar(benchmark::State& state) {
+    const std::string input = MakeScopedNames(state.range(0));
+
+    for (auto _ : state) {
+        auto result = stevensStringLib::separate(input, "::");
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(Separate_Runtime_TwoChar)->Arg(1000);
+
+static void Separate_Fixed_TwoChar(benchmark::State& state) {
+    const std::string input = MakeScopedNames(state.range(0));
+
+    for (auto _ : state) {
+        auto result = stevensStringLib::separate<':', ':'>(input);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(Separate_Fixed_TwoChar)->Arg(1000);
+
+static void Separate_Library_Searcher(benchmark::State& state) {
+    std::string input = "apple and banana and cherry and date and elderberry";
+    const stevensStringLib::Searcher separator(" and ");
+
+    for (auto _ : state) {
+        auto result = stevensStringLib::separate(input, separator);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(Separate_Library_Searcher);
+
+// Long records of prose, where the separator's first char (' ') is everywhere
+static std::string MakeProseRecords(size_t records) {
+    std::string input;
+    for (size_t i = 0; i < records; ++i) {
+        input += "the quick brown fox jumps over the lazy dog " + std::to_string(i) + " and ";
+    }
+    return input;
+}
+
+static void Separate_Prose_String(benchmark::State& state) {
+    const std::string input = MakeProseRecords(state.range(0));
+
+    for (auto _ : state) {
+        auto result = stevensStringLib::separate(input, " and ");
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(Separate_Prose_String)->Arg(10000);
+
+static void Separate_Prose_Searcher(benchmark::State& state) {
+    const std::string input = MakeProseRecords(state.range(0));
+    const stevensStringLib::Searcher separator(" and ");
+
+    for (auto _ : state) {
+        auto result = stevensStringLib::separate(input, separator);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(Separate_Prose_Searcher)->Arg(10000);
+
+// ============================================================================
+// LIBRARY BENCHMARKS - Lazy zero-copy split
+// ============================================================================
+
+static void Separate_SplitView_Char(benchmark::State& state) {
+    std::string input = "apple,banana,cherry,date,elderberry,fig,grape,honeydew";
+
+    for (auto _ : state) {
+        size_t totalLength = 0;
+        for (std::string_view piece : stevensStringLib::splitView(input, ',')) {
+            totalLength += piece.size();
+        }
+        benchmark::DoNotOptimize(totalLength);
+    }
+}
+BENCHMARK(Separate_SplitView_Char);
+
+// ============================================================================
+// LIBRARY BENCHMARKS - Delimiter set
+// ============================================================================
+
+static void Separate_CharSet_MixedDelimiters(benchmark::State& state) {
+    std::string input = "apple, banana;cherry\tdate elderberry,fig; grape\thoneydew";
+    const stevensStringLib::CharSet delimiters(" ,;\t");
+
+    for (auto _ : state) {
+        auto result = stevensStringLib::separate(input, delimiters);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(Separate_CharSet_MixedDelimiters);
+
+// Splitting on each delimiter in turn - what callers had to do before the CharSet overload
+static void Separate_CharSet_Baseline_Chained(benchmark::State& state) {
+    std::string input = "apple, banana;cherry\tdate elderberry,fig; grape\thoneydew";
+
+    for (auto _ : state) {
+        std::vector<std::string> result = {input};
+        for (char delimiter : {' ', ',', ';', '\t'}) {
+            std::vector<std::string> next;
+            for (const auto& piece : result) {
+                for (auto& subPiece : stevensStringLib::separate(piece, delimiter)) {
+                    next.push_back(std::move(subPiece));
+                }
+            }
+            result = std::move(next);
+        }
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(Separate_CharSet_Baseline_Chained);
+
 // ============================================================================
 // SCALING TESTS - How performance changes with input size
 // ============================================================================
@@ -106,6 +302,29 @@ BENCHMARK(Separate_Scaling)
     ->Range(8, 8<<10)
     ->Complexity(benchmark::oN);
 
+static void Separate_Scaling_FindLoop(benchmark::State& state) {
+    size_t num_elements = state.range(0);
+
+    std::string input;
+    for(size_t i = 0; i < num_elements; ++i) {
+        if(i > 0) input += ",";
+        input += "element" + std::to_string(i);
+    }
+
+    for (auto _ : state) {
+        auto result = Separate_FindLoop(input, ',', true);
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.SetComplexityN(num_elements);
+    state.SetItemsProcessed(state.iterations() * num_elements);
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(Separate_Scaling_FindLoop)
+    ->RangeMultiplier(2)
+    ->Range(8, 8<<10)
+    ->Complexity(benchmark::oN);
+
 // ============================================================================
 // WORST CASE - No separators found
 // ============================================================================
@@ -140,6 +359,18 @@ static void Separate_WorstCase_ManySeparators(benchmark::State& state) {
 BENCHMARK(Separate_WorstCase_ManySeparators)
     ->Range(8, 8<<10);
 
+static void Separate_WorstCase_ManySeparators_FindLoop(benchmark::State& state) {
+    size_t num_seps = state.range(0);
+    std::string input(num_seps, ',');
+
+    for (auto _ : state) {
+        auto result = Separate_FindLoop(input, ',', false);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(Separate_WorstCase_ManySeparators_FindLoop)
+    ->Range(8, 8<<10);
+
 // ============================================================================
 // REAL WORLD - CSV parsing
 // ============================================================================
@@ -148,13 +379,218 @@ static void Separate_CSV_RealWorld(benchmark::State& state) {
     const std::string csv_line =
         "John,Doe,john.doe@email.com,555-1234,123 Main St,New York,NY,10001";
 
+    size_t allocationsBefore = g_allocationCount.load();
     for (auto _ : state) {
         auto result = stevensStringLib::separate(csv_line, ',');
         benchmark::DoNotOptimize(result);
     }
+    ReportAllocationsPerIteration(state, allocationsBefore);
 }
 BENCHMARK(Separate_CSV_RealWorld);
 
+// Same line, parsed into one reused vector - steady state should report 0 allocs_per_iter
+static void Separate_CSV_RealWorld_Into(benchmark::State& state) {
+    const std::string csv_line =
+        "John,Doe,john.doe@email.com,555-1234,123 Main St,New York,NY,10001";
+    std::vector<std::string> fields;
+    stevensStringLib::separateInto(csv_line, ',', fields);  // Warm up capacity outside the timed loop
+
+    size_t allocationsBefore = g_allocationCount.load();
+    for (auto _ : state) {
+        stevensStringLib::separateInto(csv_line, ',', fields);
+        benchmark::DoNotOptimize(fields);
+    }
+    ReportAllocationsPerIteration(state, allocationsBefore);
+}
+BENCHMARK(Separate_CSV_RealWorld_Into);
+
+static void Separate_CSV_RealWorld_IntoViews(benchmark::State& state) {
+    const std::string csv_line =
+        "John,Doe,john.doe@email.com,555-1234,123 Main St,New York,NY,10001";
+    std::vector<std::string_view> fields;
+    stevensStringLib::separateInto(csv_line, ',', fields);
+
+    size_t allocationsBefore = g_allocationCount.load();
+    for (auto _ : state) {
+        stevensStringLib::separateInto(csv_line, ',', fields);
+        benchmark::DoNotOptimize(fields);
+    }
+    ReportAllocationsPerIteration(state, allocationsBefore);
+}
+BENCHMARK(Separate_CSV_RealWorld_IntoViews);
+
+static void Separate_CSV_RealWorld_TokenTable(benchmark::State& state) {
+    const std::string csv_line =
+        "John,Doe,john.doe@email.com,555-1234,123 Main St,New York,NY,10001";
+    stevensStringLib::TokenTable fields;
+    stevensStringLib::separateInto(csv_line, ',', fields);
+
+    size_t allocationsBefore = g_allocationCount.load();
+    for (auto _ : state) {
+        stevensStringLib::separateInto(csv_line, ',', fields);
+        benchmark::DoNotOptimize(fields);
+    }
+    ReportAllocationsPerIteration(state, allocationsBefore);
+}
+BENCHMARK(Separate_CSV_RealWorld_TokenTable);
+
+// Same line through the RFC 4180 CSV parser - zero-copy field views, quote-aware
+static void Separate_CSV_RealWorld_ForEachCsvRecord(benchmark::State& state) {
+    const std::string csv_line =
+        "John,Doe,john.doe@email.com,555-1234,123 Main St,New York,NY,10001";
+
+    size_t allocationsBefore = g_allocationCount.load();
+    for (auto _ : state) {
+        size_t fields = 0;
+        stevensStringLib::forEachCsvRecord(csv_line, [&](const std::vector<stevensStringLib::CsvField>& record) {
+            fields += record.size();
+        });
+        benchmark::DoNotOptimize(fields);
+    }
+    ReportAllocationsPerIteration(state, allocationsBefore);
+}
+BENCHMARK(Separate_CSV_RealWorld_ForEachCsvRecord);
+
+// Whole CSV file with quoted fields (embedded commas, escaped quotes, multi-line values)
+static std::string MakeQuotedCsv(size_t records) {
+    std::string csv = "id,name,comment\n";
+    for (size_t i = 0; i < records; ++i) {
+        csv += std::to_string(i) + ",\"Doe, John\",\"said \"\"hi\"\"\nthen left\"\n";
+    }
+    return csv;
+}
+
+static void Separate_CSV_File_ForEachCsvRecord(benchmark::State& state) {
+    const std::string csv = MakeQuotedCsv(state.range(0));
+
+    for (auto _ : state) {
+        size_t fields = 0;
+        stevensStringLib::forEachCsvRecord(csv, [&](const std::vector<stevensStringLib::CsvField>& record) {
+            fields += record.size();
+        });
+        benchmark::DoNotOptimize(fields);
+    }
+    state.SetBytesProcessed(state.iterations() * csv.size());
+}
+BENCHMARK(Separate_CSV_File_ForEachCsvRecord)->Arg(1000)->Arg(100000);
+
+// Column scan over many short tokens: vector of strings vs one contiguous TokenTable
+static void Separate_ColumnScan_Vector(benchmark::State& state) {
+    std::string input;
+    for (int i = 0; i < 100000; ++i) input += std::to_string(i % 1000) + ",";
+    auto tokens = stevensStringLib::separate(input, ',');
+
+    for (auto _ : state) {
+        size_t total = 0;
+        for (const auto& token : tokens) total += token.size();
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * tokens.size());
+}
+BENCHMARK(Separate_ColumnScan_Vector);
+
+static void Separate_ColumnScan_TokenTable(benchmark::State& state) {
+    std::string input;
+    for (int i = 0; i < 100000; ++i) input += std::to_string(i % 1000) + ",";
+    stevensStringLib::TokenTable tokens;
+    stevensStringLib::separateInto(input, ',', tokens);
+
+    for (auto _ : state) {
+        size_t total = 0;
+        for (std::string_view token : tokens) total += token.size();
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * tokens.size());
+}
+BENCHMARK(Separate_ColumnScan_TokenTable);
+
+// ============================================================================
+// PARALLEL - Multi-megabyte inputs, serial vs chunked across threads
+// ============================================================================
+
+static std::string MakeLargeLineInput(size_t megabytes) {
+    std::string input;
+    input.reserve(megabytes << 20);
+    for (size_t i = 0; input.size() < (megabytes << 20); ++i) {
+        input += "record " + std::to_string(i) + ",some,field,values\n";
+    }
+    return input;
+}
+
+static void Separate_Large_Serial(benchmark::State& state) {
+    const std::string input = MakeLargeLineInput(state.range(0));
+
+    for (auto _ : state) {
+        auto result = stevensStringLib::separate(input, '\n');
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(Separate_Large_Serial)->Arg(8)->Arg(64)->Unit(benchmark::kMillisecond);
+
+static void Separate_Large_Parallel(benchmark::State& state) {
+    const std::string input = MakeLargeLineInput(state.range(0));
+    const stevensStringLib::ParallelSettings settings;
+
+    for (auto _ : state) {
+        auto result = stevensStringLib::separate(input, '\n', true, settings);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(Separate_Large_Parallel)->Arg(8)->Arg(64)->Unit(benchmark::kMillisecond);
+
+// ============================================================================
+// STREAMING - Tokenizing through a bounded buffer instead of the whole input
+// ============================================================================
+
+static void Separate_Stream_ForEachToken(benchmark::State& state) {
+    const std::string input = MakeLargeLineInput(8);
+
+    for (auto _ : state) {
+        std::istringstream stream(input);
+        size_t lines = 0;
+        stevensStringLib::forEachToken(stream, '\n', [&](std::string_view line) {
+            lines += !line.empty();
+        });
+        benchmark::DoNotOptimize(lines);
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(Separate_Stream_ForEachToken)->Unit(benchmark::kMillisecond);
+
+// ============================================================================
+// BOUNDED - First fields of a long log line
+// ============================================================================
+
+static std::string MakeLogLine() {
+    std::string line = "2024-05-01 12:00:00 INFO";
+    for (int i = 0; i < 200; ++i) line += " payload" + std::to_string(i);
+    return line;
+}
+
+static void Separate_LogLine_FirstTwoFields_Separate(benchmark::State& state) {
+    const std::string line = MakeLogLine();
+
+    for (auto _ : state) {
+        auto fields = stevensStringLib::separate(line, ' ');
+        std::string_view date = fields[0], time = fields[1];
+        benchmark::DoNotOptimize(date);
+        benchmark::DoNotOptimize(time);
+    }
+}
+BENCHMARK(Separate_LogLine_FirstTwoFields_Separate);
+
+static void Separate_LogLine_FirstTwoFields_SeparateN(benchmark::State& state) {
+    const std::string line = MakeLogLine();
+
+    for (auto _ : state) {
+        auto result = stevensStringLib::separateN(line, ' ', 2);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(Separate_LogLine_FirstTwoFields_SeparateN);
+
 // ============================================================================
 // REAL WORLD - Path parsing
 // ============================================================================
@@ -182,3 +618,32 @@ static void Separate_EmptySeparator(benchmark::State& state) {
     }
 }
 BENCHMARK(Separate_EmptySeparator);
+
+// Character-level tokenization of a large, mostly-ASCII corpus
+static std::string MakeMostlyAsciiCorpus() {
+    std::string corpus;
+    for (int i = 0; i < 2000; ++i) corpus += "The quick brown fox jumps over the lazy dog. Naïve café! ";
+    return corpus;
+}
+
+static void Separate_EmptySeparator_Corpus(benchmark::State& state) {
+    const std::string corpus = MakeMostlyAsciiCorpus();
+
+    for (auto _ : state) {
+        auto result = stevensStringLib::separate(corpus, "");
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(state.iterations() * corpus.size());
+}
+BENCHMARK(Separate_EmptySeparator_Corpus);
+
+static void Separate_Codepoints_Corpus(benchmark::State& state) {
+    const std::string corpus = MakeMostlyAsciiCorpus();
+
+    for (auto _ : state) {
+        auto result = stevensStringLib::separateCodepoints(corpus);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(state.iterations() * corpus.size());
+}
+BENCHMARK(Separate_Codepoints_Corpus);
@@ -123,3 +123,32 @@ static void Validation_MixedInputs(benchmark::State& state) {
     }
 }
 BENCHMARK(Validation_MixedInputs);
+
+// ============================================================================
+// CHARACTER SETS - containsOnly with a string of chars vs a compiled CharSet
+// ============================================================================
+
+static const char* const kIdentifierChars = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_";
+
+static void ContainsOnly_String(benchmark::State& state) {
+    std::string input(state.range(0), 'x');
+
+    for (auto _ : state) {
+        bool result = stevensStringLib::containsOnly(input, kIdentifierChars);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(ContainsOnly_String)->Arg(16)->Arg(1024);
+
+static void ContainsOnly_CharSet(benchmark::State& state) {
+    std::string input(state.range(0), 'x');
+    const stevensStringLib::CharSet identifierChars(kIdentifierChars);
+
+    for (auto _ : state) {
+        bool result = stevensStringLib::containsOnly(input, identifierChars);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(ContainsOnly_CharSet)->Arg(16)->Arg(1024);
@@ -50,10 +50,41 @@
 #include<map>
 #include<unordered_map>
 #include<random>
+#include<iterator>
+#include<cstring>
+#include<cstdio>
+#include<cstdint>
+#include<thread>
+#include<exception>
+#include<system_error>
+#include<type_traits>
+#include<cerrno>
 
 #include<utf8.h> // utf8cpp - UTF-8 <-> UTF-32 codec, see utf8to32()/circularIndex()
 #include<utf8proc.h> // per-codepoint display width (East Asian Width), see lineDisplayWidth()
 
+// SIMD scanning kernels (see detail::forEachCharPosition()). SSE2 is part of the x86-64 baseline,
+// so it's always used there. AVX2 isn't, so on GCC/Clang it's compiled per-function via
+// __attribute__((target("avx2"))) and only selected after a runtime CPU check - no -mavx2 needed.
+// Define STEVENSSTRINGLIB_DISABLE_SIMD before including this header to force the portable paths.
+#if !defined(STEVENSSTRINGLIB_DISABLE_SIMD) && (defined(__x86_64__) || defined(_M_X64))
+    #define STEVENSSTRINGLIB_X86_SIMD
+    #include<emmintrin.h>
+    #if defined(__GNUC__) || defined(__clang__)
+        #define STEVENSSTRINGLIB_AVX2_DISPATCH
+        #include<immintrin.h>
+    #endif
+#endif
+#if defined(_MSC_VER) && !defined(__clang__)
+    #include<intrin.h> // _BitScanForward/_BitScanReverse, see detail::lowestSetBit()
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+    #define STEVENSSTRINGLIB_POSIX_IO
+    #include<unistd.h> // read(), see forEachToken()
+    #include<sys/uio.h> // writev(), see JoinView::writeTo()
+    #include<climits> // IOV_MAX
+#endif
+
 
 namespace stevensStringLib
 {
@@ -220,416 +251,6489 @@ namespace stevensStringLib
 
             return line.length();
         }
-    }
-
-
-    /**
-     * @deprecated
-     * In C++23 and onward, please use the std::string::contains() method instead of this function.
-     * 
-     * Given a string, determine whether it has an occurrence of the substring somewhere 
-     * within it.
-     * 
-     *  @param str - The std::string we are examining to see if it contains the substring.
-     *  @param substring - The substring we are checking to if it is contained in str.
-     * 
-     *  @retval bool - indicates that input std::string contains the substring (true) or not (false).
-     */
-    inline bool contains(   const std::string_view & str,
-                            const std::string_view & substring   )
-    {
-        return (str.find(substring) != std::string::npos);
-    }
 
 
-    /**
-     * @deprecated
-     * In C++23 and onward, please use the std::string::contains() method instead of this function.
-     * 
-     * Given a string, determine whether it has an occurrence of a character somewhere 
-     * within it.
-     * 
-     *  @param str - The std::string we are examining to see if it contains the substring.
-     *  @param ch - The char we are checking to see if it is contained in str.
-     * 
-     *  @retval bool -  indicates that input std::string contains the substring (true) or not (false).
-     */
-    inline bool contains(   const std::string_view & str,
-                            const char ch  )
-    {
-        return (str.find(ch) != std::string::npos);
-    }
+        /**
+         * Index of the lowest set bit of a non-zero SIMD movemask - i.e. the offset, within the
+         * block the mask was built from, of the first byte that matched.
+         *
+         * @param mask - A non-zero bitmask.
+         *
+         * @retval unsigned int - The number of trailing zero bits in mask.
+        */
+        inline unsigned int lowestSetBit(uint32_t mask)
+        {
+        #if defined(_MSC_VER) && !defined(__clang__)
+            unsigned long index;
+            _BitScanForward(&index, mask);
+            return static_cast<unsigned int>(index);
+        #else
+            return static_cast<unsigned int>(__builtin_ctz(mask));
+        #endif
+        }
 
 
-    /**
-     * @brief Given a string, determine if it contains only the characters in the given string.
-     * 
-     * Example:
-     * containsOnly("11101112222","12")
-     * 
-     * Result: false, str contains the character '0', which is not equal to '1', or '2';
-     * 
-     * @param str - The std::string we are checking to see if it only contains characters present in the chars string.
-     * @param chars - A std::string of characters we are checking to see if str contains any characters that are not in chars.
-     * @retval bool - true if str contains only instances of keys in substrs. False if str contains at least one substring that is not present as a key in substrs.
-     */
-    inline bool containsOnly(   const std::string_view & str,
-                                const std::string_view & chars )
-    {
-        //If chars is empty, we are limiting a std::string that returns as true to also be empty.
-        if(chars.empty())
+        /**
+         * 64-bit variant of lowestSetBit(), for masks covering a 64-byte block.
+         *
+         * @param mask - A non-zero bitmask.
+         *
+         * @retval unsigned int - The number of trailing zero bits in mask.
+        */
+        inline unsigned int lowestSetBit(uint64_t mask)
         {
-            if(str.empty())
-            {
-                //The std::string contains nothing and it can only contain no characters, therefore return true
-                return true;
-            }
-            else
-            {
-                //The std::string contains something while it can only contain no characters, therefore return false
-                return false;
-            }
+        #if defined(_MSC_VER) && !defined(__clang__)
+            unsigned long index;
+            _BitScanForward64(&index, mask);
+            return static_cast<unsigned int>(index);
+        #else
+            return static_cast<unsigned int>(__builtin_ctzll(mask));
+        #endif
         }
 
-        return str.find_first_not_of(chars) == std::string::npos;
-    }
-
 
-     /**
-     * Given a std::string str, erase the last n characters of the string.
-     * 
-     * Credit to Varun: https://thispointer.com/remove-last-n-characters-from-a-string-in-c/
-     * 
-     * @param str - The std::string we want to erase characters from the end of.
-     * @param n - The number of characters we want to erase
-     * 
-     * @retval std::string - The string str having n characters erased from the end of it.
-    */
-    inline std::string eraseCharsFromEnd(   std::string str,
-                                            size_t n   )
-    {
-        //Can't erase from empty strings, and we can't erase more characters from the std::string than what we have
-        if(str.size() <= n)
+        /**
+         * Index of the highest set bit of a non-zero SIMD movemask - i.e. the offset, within the
+         * block the mask was built from, of the last byte that matched.
+         *
+         * @param mask - A non-zero bitmask.
+         *
+         * @retval unsigned int - 31 minus the number of leading zero bits in mask.
+        */
+        inline unsigned int highestSetBit(uint32_t mask)
         {
-            return "";
+        #if defined(_MSC_VER) && !defined(__clang__)
+            unsigned long index;
+            _BitScanReverse(&index, mask);
+            return static_cast<unsigned int>(index);
+        #else
+            return 31u - static_cast<unsigned int>(__builtin_clz(mask));
+        #endif
         }
 
-        str.erase(str.size() - n);
-        return str;
-    }
-
 
-    /**
-     * @brief Given a std::string str, erase the first n characters of the string.
-     * 
-     * Credit to Michael Krelin: https://stackoverflow.com/a/12692267/16511184
-     * 
-     * @param str - The std::string we want to erase characters from the start of.
-     * @param n - The number of characters we want to erase
-     * 
-     */
-    inline std::string eraseCharsFromStart( std::string str,
-                                            size_t n    )
-    {
-        //Can't erase from empty strings, and we can't erase more characters from the std::string than what we have
-        if(str.size() <= n)
+        /**
+         * The number of set bits in a SIMD movemask - i.e. how many bytes of the block it was built
+         * from matched.
+         *
+         * @param mask - A bitmask.
+         *
+         * @retval unsigned int - The number of set bits in mask.
+        */
+        inline unsigned int setBitCount(uint32_t mask)
         {
-            return "";
+        #if defined(_MSC_VER) && !defined(__clang__)
+            mask = mask - ((mask >> 1) & 0x55555555u);
+            mask = (mask & 0x33333333u) + ((mask >> 2) & 0x33333333u);
+            return static_cast<unsigned int>((((mask + (mask >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24);
+        #else
+            return static_cast<unsigned int>(__builtin_popcount(mask));
+        #endif
         }
 
-        str.erase(0, n);
-        return str;
-    }
-
 
-    /**
-     * @deprecated
-     * In C++20 and onward, please use std::string.starts_with instead.
-     * 
-     * @brief Check a std::string to see if it begins with a substring.
-     * 
-     * @param str - The std::string we are checking to see if it begins with another substring.
-     * @param substr - The substring we are checking the beginning of str against to see if they are equal.
-     * 
-     * @retval bool - True if the std::string str begins with substr. False if the std::string str does NOT begin with substr.
-     */
-    inline bool startsWith(     const std::string_view & str, 
-                                const std::string_view & substr )
-    {
-        //If the substring is longer than the string, then it's not possible for the std::string to start with the substring
-        if(str.length() < substr.length())
+        /**
+         * Whether the CPU we're running on supports AVX2, checked once and cached. Lets the SIMD
+         * scanning kernels below pick their widest variant at runtime, so the same binary runs
+         * the AVX2 path on machines that have it and falls back to SSE2 on machines that don't,
+         * without the library having to be compiled with -mavx2.
+         *
+         * @retval bool - True if the AVX2 kernels can be used on this CPU.
+        */
+        inline bool cpuSupportsAvx2()
         {
+        #if defined(STEVENSSTRINGLIB_AVX2_DISPATCH)
+            static const bool supported = __builtin_cpu_supports("avx2");
+            return supported;
+        #else
             return false;
+        #endif
         }
-        //Check the beginning of str to see if it is equivalent to substr
-        if(str.substr(0,substr.length()) == substr)
+
+
+        /**
+         * Call visitor(index) for every index at or after from where str[index] == ch, in
+         * increasing order, stopping early if visitor returns false. Portable fallback behind
+         * forEachCharPosition(), built on memchr (which the C library already vectorizes
+         * internally, just with a function call per match).
+         *
+         * @retval bool - False if visitor stopped the scan early, true otherwise.
+        */
+        template<typename Visitor>
+        inline bool forEachCharPositionScalar(  const std::string_view & str,
+                                                size_t from,
+                                                const char ch,
+                                                Visitor & visitor   )
         {
+            const char * const data = str.data();
+            const size_t length = str.length();
+            while(from < length)
+            {
+                const void * found = std::memchr(data + from, ch, length - from);
+                if(found == nullptr)
+                {
+                    break;
+                }
+                size_t index = static_cast<size_t>(static_cast<const char *>(found) - data);
+                if(!visitor(index))
+                {
+                    return false;
+                }
+                from = index + 1;
+            }
             return true;
         }
-        return false;
-    }
 
 
-    /**
-     * @brief Check a std::string to see if it ends with a substring.
-     * 
-     * @param str - The std::string we are checking the end of to see if it ends with substr.
-     * @param substr - The substr we are checking to see if str ends with.
-     * 
-     * @retval bool - True if the std::string str ends with substr. False if the str does not end with with substr.
-     */
-    inline bool endsWith(   const std::string_view & str,
-                            const std::string_view & substr    )
-    {
-        //If the substring is longer than the string, then it's not possible for the std::string to start with the substring
-        if (str.size() < substr.size())
+    #if defined(STEVENSSTRINGLIB_X86_SIMD)
+        /**
+         * SSE2 variant of forEachCharPositionScalar(): compares 16 bytes at a time against ch and
+         * turns the result into a bitmask (compare + movemask), then walks the set bits - so every
+         * match in a block is found by the same single compare, no matter how densely packed the
+         * matches are. SSE2 is part of the x86-64 baseline, so this needs no runtime check.
+        */
+        template<typename Visitor>
+        inline bool forEachCharPositionSse2(    const std::string_view & str,
+                                                size_t from,
+                                                const char ch,
+                                                Visitor & visitor   )
         {
-            return false;
+            const char * const data = str.data();
+            const size_t length = str.length();
+            const __m128i needle = _mm_set1_epi8(ch);
+            for(; from + 16 <= length; from += 16)
+            {
+                __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + from));
+                uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+                while(mask != 0)
+                {
+                    if(!visitor(from + lowestSetBit(mask)))
+                    {
+                        return false;
+                    }
+                    mask &= mask - 1; // clear the bit we just visited
+                }
+            }
+            return forEachCharPositionScalar(str, from, ch, visitor);
         }
-        return std::equal(substr.rbegin(), substr.rend(), str.rbegin());
-    }
-
+    #endif
 
-    /**
-     * Given a std::string str, find all occurrences of a substring within it. Returns a vector of all of the indices that the substring
-     * occurs at within the std::string str.
-     * 
-     * Credit to Benjamin Lindley: https://stackoverflow.com/a/4034809
-     * 
-     * @param str - The std::string we are searching for the substring in.
-     * @param substr - The substring we are looking for within std::string str.
-     * 
-     * @retval std::vector<size_t> - A vector containing all indices in increasing order that the substr occurs at.
-    */
-    inline std::vector<size_t> findAll(     const std::string & str,
-                                            const std::string & substr  )
-    {
-        std::vector<size_t> positions;
 
-        size_t pos = str.find(substr, 0);
-        while(pos != std::string::npos)
+    #if defined(STEVENSSTRINGLIB_AVX2_DISPATCH)
+        /**
+         * AVX2 variant of forEachCharPositionSse2() - the same compare + movemask scan, 32 bytes
+         * at a time. Compiled for AVX2 via a target attribute rather than a global -mavx2 flag,
+         * and only ever called after cpuSupportsAvx2() says it's safe.
+        */
+        template<typename Visitor>
+        __attribute__((target("avx2")))
+        inline bool forEachCharPositionAvx2(    const std::string_view & str,
+                                                size_t from,
+                                                const char ch,
+                                                Visitor & visitor   )
         {
-            positions.push_back(pos);
-            pos = str.find(substr,pos+1);
+            const char * const data = str.data();
+            const size_t length = str.length();
+            const __m256i needle = _mm256_set1_epi8(ch);
+            for(; from + 32 <= length; from += 32)
+            {
+                __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + from));
+                uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+                while(mask != 0)
+                {
+                    if(!visitor(from + lowestSetBit(mask)))
+                    {
+                        return false;
+                    }
+                    mask &= mask - 1;
+                }
+            }
+            return forEachCharPositionSse2(str, from, ch, visitor);
         }
+    #endif
 
-        return positions;
-    }
-
-
-    /**
-     * Given a std::string str, find all occurrences of a character within it. Returns a vector of all of the indices that the character
-     * occurs at within the std::string str.
-     * 
-     * Credit to Benjamin Lindley: https://stackoverflow.com/a/4034809
-     * 
-     * @param str - The std::string we are searching for the substring in.
-     * @param ch - The character we are looking for within std::string str.
-     * 
-     * @retval std::vector<size_t> - A vector containing all indices in increasing order that ch occurs at.
-    */
-    inline std::vector<size_t> findAll(     const std::string & str,
-                                            const char ch  )
-    {
-        std::vector<size_t> positions;
 
-        size_t pos = str.find(ch, 0);
-        while(pos != std::string::npos)
+        /**
+         * Portable fallback behind countChar(): counts the occurrences of ch at or after from.
+        */
+        inline size_t countCharScalar(const std::string_view & str, size_t from, const char ch)
         {
-            positions.push_back(pos);
-            pos = str.find(ch,pos+1);
+            return static_cast<size_t>(std::count(str.begin() + from, str.end(), ch));
         }
 
-        return positions;
-    }
+    #if defined(STEVENSSTRINGLIB_X86_SIMD)
+        /**
+         * SSE2 variant of countCharScalar().
+        */
+        inline size_t countCharSse2(const std::string_view & str, size_t from, const char ch)
+        {
+            const char * const data = str.data();
+            const size_t length = str.length();
+            const __m128i needle = _mm_set1_epi8(ch);
+            size_t count = 0;
+            for(; from + 16 <= length; from += 16)
+            {
+                __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + from));
+                count += setBitCount(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle))));
+            }
+            return count + countCharScalar(str, from, ch);
+        }
+    #endif
 
+    #if defined(STEVENSSTRINGLIB_AVX2_DISPATCH)
+        /**
+         * AVX2 variant of countCharScalar() - every AVX2 CPU also has POPCNT, so it's enabled too.
+        */
+        __attribute__((target("avx2,popcnt")))
+        inline size_t countCharAvx2(const std::string_view & str, size_t from, const char ch)
+        {
+            const char * const data = str.data();
+            const size_t length = str.length();
+            const __m256i needle = _mm256_set1_epi8(ch);
+            size_t count = 0;
+            for(; from + 32 <= length; from += 32)
+            {
+                __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + from));
+                count += static_cast<size_t>(__builtin_popcount(
+                    static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)))));
+            }
+            return count + countCharSse2(str, from, ch);
+        }
+    #endif
 
-    /**
-     * Separates a std::string by a separator character. Returns a vector of strings that were separated.
-     * 
-     * Example:
-     * 
+        /**
+         * Count the bytes in str equal to ch without recording where they are - compare + movemask
+         * + popcount over 16 (SSE2) or 32 (AVX2) bytes at a time, dispatched the same way as
+         * forEachCharPosition(). Lets separate() reserve its result vector exactly up front.
+         *
+         * @param str - The string to scan.
+         * @param ch - The char to count.
+         *
+         * @retval size_t - The number of occurrences of ch in str.
+        */
+        inline size_t countChar(const std::string_view & str, const char ch)
+        {
+        #if defined(STEVENSSTRINGLIB_AVX2_DISPATCH)
+            if(cpuSupportsAvx2())
+            {
+                return countCharAvx2(str, 0, ch);
+            }
+        #endif
+        #if defined(STEVENSSTRINGLIB_X86_SIMD)
+            return countCharSse2(str, 0, ch);
+        #else
+            return countCharScalar(str, 0, ch);
+        #endif
+        }
+
+
+        /**
+         * Index of the first non-ASCII byte (high bit set) in str at or after from, or
+         * str.length() if the rest of str is all ASCII. Portable fallback behind asciiRunEnd(),
+         * checking 8 bytes at a time with one 64-bit mask test.
+        */
+        inline size_t asciiRunEndScalar(const std::string_view & str, size_t from)
+        {
+            const char * const data = str.data();
+            const size_t length = str.length();
+            for(; from + 8 <= length; from += 8)
+            {
+                uint64_t word;
+                std::memcpy(&word, data + from, sizeof(word));
+                if((word & 0x8080808080808080ull) != 0)
+                {
+                    break;
+                }
+            }
+            while(from < length && static_cast<unsigned char>(data[from]) < 0x80)
+            {
+                from++;
+            }
+            return from;
+        }
+
+    #if defined(STEVENSSTRINGLIB_X86_SIMD)
+        /**
+         * SSE2 variant of asciiRunEndScalar() - movemask alone collects the high bit of each of 16
+         * bytes, so no compare is needed at all.
+        */
+        inline size_t asciiRunEndSse2(const std::string_view & str, size_t from)
+        {
+            const char * const data = str.data();
+            const size_t length = str.length();
+            for(; from + 16 <= length; from += 16)
+            {
+                __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + from));
+                uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(block));
+                if(mask != 0)
+                {
+                    return from + lowestSetBit(mask);
+                }
+            }
+            return asciiRunEndScalar(str, from);
+        }
+    #endif
+
+    #if defined(STEVENSSTRINGLIB_AVX2_DISPATCH)
+        /**
+         * AVX2 variant of asciiRunEndScalar(), 32 bytes at a time.
+        */
+        __attribute__((target("avx2")))
+        inline size_t asciiRunEndAvx2(const std::string_view & str, size_t from)
+        {
+            const char * const data = str.data();
+            const size_t length = str.length();
+            for(; from + 32 <= length; from += 32)
+            {
+                __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + from));
+                uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(block));
+                if(mask != 0)
+                {
+                    return from + lowestSetBit(mask);
+                }
+            }
+            return asciiRunEndSse2(str, from);
+        }
+    #endif
+
+        /**
+         * Index of the first non-ASCII byte in str at or after from, or str.length() if there is
+         * none - i.e. where the run of plain ASCII starting at from ends. Dispatched the same way
+         * as forEachCharPosition().
+         *
+         * @param str - The string to scan.
+         * @param from - The index to start scanning at.
+         *
+         * @retval size_t - The end of the ASCII run starting at from.
+        */
+        inline size_t asciiRunEnd(const std::string_view & str, size_t from)
+        {
+        #if defined(STEVENSSTRINGLIB_AVX2_DISPATCH)
+            if(cpuSupportsAvx2())
+            {
+                return asciiRunEndAvx2(str, from);
+            }
+        #endif
+        #if defined(STEVENSSTRINGLIB_X86_SIMD)
+            return asciiRunEndSse2(str, from);
+        #else
+            return asciiRunEndScalar(str, from);
+        #endif
+        }
+
+
+        /**
+         * Call visitor(codepoint) for every codepoint of str, in order, with codepoint a
+         * std::string_view of its (one to four) UTF-8 bytes in str. ASCII runs are found with
+         * asciiRunEnd() and handed out a byte at a time with no decoding at all; only the
+         * multi-byte characters go through utf8::next().
+         *
+         * @param str - The UTF-8 string to walk.
+         * @param visitor - Callable taking a std::string_view codepoint.
+        */
+        template<typename Visitor>
+        inline void forEachCodepoint(const std::string_view & str, Visitor && visitor)
+        {
+            size_t index = 0;
+            while(index < str.length())
+            {
+                const size_t runEnd = asciiRunEnd(str, index);
+                for(; index < runEnd; index++)
+                {
+                    visitor(str.substr(index, 1));
+                }
+                if(index < str.length())
+                {
+                    auto it = str.begin() + index;
+                    utf8::next(it, str.end()); // advances it past one codepoint
+                    size_t after = static_cast<size_t>(it - str.begin());
+                    visitor(str.substr(index, after - index));
+                    index = after;
+                }
+            }
+        }
+
+
+        /**
+         * Call visitor(index) for every index in str where str[index] == ch, in increasing order,
+         * stopping early as soon as visitor returns false. The shared single-char scanning kernel
+         * behind separate() - picks the widest SIMD variant the running CPU supports (AVX2, then
+         * SSE2, then the portable memchr loop), so every separator position is found in one pass.
+         *
+         * @param str - The string to scan.
+         * @param ch - The char to look for.
+         * @param visitor - Callable taking a size_t index and returning bool (false to stop).
+         *
+         * @retval bool - False if visitor stopped the scan early, true otherwise.
+        */
+        template<typename Visitor>
+        inline bool forEachCharPosition(    const std::string_view & str,
+                                            const char ch,
+                                            Visitor && visitor  )
+        {
+        #if defined(STEVENSSTRINGLIB_AVX2_DISPATCH)
+            if(cpuSupportsAvx2())
+            {
+                return forEachCharPositionAvx2(str, 0, ch, visitor);
+            }
+        #endif
+        #if defined(STEVENSSTRINGLIB_X86_SIMD)
+            return forEachCharPositionSse2(str, 0, ch, visitor);
+        #else
+            return forEachCharPositionScalar(str, 0, ch, visitor);
+        #endif
+        }
+
+
+        /**
+         * The compiled lookup tables behind a CharSet (see that class's doc comment): a 256-bit
+         * bitmap with one bit per byte value for the scalar path, plus a pair of 16-entry nibble
+         * tables for the SIMD path. The nibble tables classify a byte by looking up its low and high
+         * nibble separately (one shuffle each) and ANDing the results - a byte is in the set when
+         * lowNibbles[byte & 0xF] has the bit for (byte >> 4) set. Eight bits only cover the eight
+         * ASCII high nibbles, so the SIMD path is only usable when every member is ASCII.
+        */
+        struct CharSetTables
+        {
+            uint64_t bitmap[4] = { 0, 0, 0, 0 };
+            alignas(16) uint8_t lowNibbles[16] = {};
+            alignas(16) uint8_t highNibbles[16] = {};
+            bool asciiOnly = true;
+
+            void add(unsigned char byte)
+            {
+                bitmap[byte >> 6] |= (uint64_t(1) << (byte & 63));
+                if(byte < 0x80)
+                {
+                    lowNibbles[byte & 0x0F] |= static_cast<uint8_t>(1u << (byte >> 4));
+                    highNibbles[byte >> 4] = static_cast<uint8_t>(1u << (byte >> 4));
+                }
+                else
+                {
+                    asciiOnly = false;
+                }
+            }
+
+            bool test(unsigned char byte) const
+            {
+                return (bitmap[byte >> 6] >> (byte & 63)) & 1;
+            }
+        };
+
+
+        /**
+         * Call visitor(index) for every index at or after from where str[index] is in the set,
+         * stopping early if visitor returns false. Portable fallback behind forEachCharSetPosition() -
+         * one bitmap test per byte.
+         *
+         * @retval bool - False if visitor stopped the scan early, true otherwise.
+        */
+        template<typename Visitor>
+        inline bool forEachCharSetPositionScalar(   const std::string_view & str,
+                                                    size_t from,
+                                                    const CharSetTables & set,
+                                                    Visitor & visitor   )
+        {
+            for(; from < str.length(); from++)
+            {
+                if(set.test(static_cast<unsigned char>(str[from])) && !visitor(from))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+
+        /**
+         * The first index at or after from where str[index]'s membership of the set is members -
+         * i.e. the first member when members is true, the first non-member when it's false.
+         * Portable fallback behind findCharSetPosition() - one bitmap test per byte.
+         *
+         * @retval size_t - The index found, or std::string_view::npos if there is none.
+        */
+        inline size_t findCharSetPositionScalar(    const std::string_view & str,
+                                                    size_t from,
+                                                    const CharSetTables & set,
+                                                    const bool members  )
+        {
+            for(; from < str.length(); from++)
+            {
+                if(set.test(static_cast<unsigned char>(str[from])) == members)
+                {
+                    return from;
+                }
+            }
+            return std::string_view::npos;
+        }
+
+
+        /**
+         * Backwards counterpart of findCharSetPositionScalar(): the last index before end where
+         * str[index]'s membership of the set is members.
+         *
+         * @retval size_t - The index found, or std::string_view::npos if there is none.
+        */
+        inline size_t findLastCharSetPositionScalar(    const std::string_view & str,
+                                                        size_t end,
+                                                        const CharSetTables & set,
+                                                        const bool members  )
+        {
+            while(end > 0)
+            {
+                end--;
+                if(set.test(static_cast<unsigned char>(str[end])) == members)
+                {
+                    return end;
+                }
+            }
+            return std::string_view::npos;
+        }
+
+
+    #if defined(STEVENSSTRINGLIB_AVX2_DISPATCH)
+        /**
+         * Classify 32 bytes at once against a CharSet with two nibble-table shuffles and an AND
+         * (see CharSetTables). lowTable and highTable are set.lowNibbles and set.highNibbles
+         * broadcast to both 128-bit lanes. Requires set.asciiOnly.
+         *
+         * @retval uint32_t - Bit i is set if data[i] is a member of the set.
+        */
+        __attribute__((target("avx2")))
+        inline uint32_t charSetMembersAvx2( const char * data,
+                                            const __m256i & lowTable,
+                                            const __m256i & highTable  )
+        {
+            const __m256i nibbleMask = _mm256_set1_epi8(0x0F);
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data));
+            __m256i lowNibbles = _mm256_and_si256(block, nibbleMask);
+            __m256i highNibbles = _mm256_and_si256(_mm256_srli_epi16(block, 4), nibbleMask);
+            __m256i classified = _mm256_and_si256(  _mm256_shuffle_epi8(lowTable, lowNibbles),
+                                                    _mm256_shuffle_epi8(highTable, highNibbles) );
+            return ~static_cast<uint32_t>(
+                _mm256_movemask_epi8(_mm256_cmpeq_epi8(classified, _mm256_setzero_si256())));
+        }
+
+
+        /**
+         * Broadcast one of a CharSetTables' 16-entry nibble tables to both lanes of a 256-bit
+         * register, for charSetMembersAvx2().
+        */
+        __attribute__((target("avx2")))
+        inline __m256i broadcastNibbleTableAvx2(const uint8_t (&table)[16])
+        {
+            return _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(table)));
+        }
+
+
+        /**
+         * AVX2 variant of forEachCharSetPositionScalar(): classifies 32 bytes at a time with
+         * charSetMembersAvx2(), then walks the resulting mask like forEachCharPositionAvx2() does.
+         * Requires set.asciiOnly.
+        */
+        template<typename Visitor>
+        __attribute__((target("avx2")))
+        inline bool forEachCharSetPositionAvx2( const std::string_view & str,
+                                                size_t from,
+                                                const CharSetTables & set,
+                                                Visitor & visitor   )
+        {
+            const char * const data = str.data();
+            const size_t length = str.length();
+            const __m256i lowTable = broadcastNibbleTableAvx2(set.lowNibbles);
+            const __m256i highTable = broadcastNibbleTableAvx2(set.highNibbles);
+            for(; from + 32 <= length; from += 32)
+            {
+                uint32_t mask = charSetMembersAvx2(data + from, lowTable, highTable);
+                while(mask != 0)
+                {
+                    if(!visitor(from + lowestSetBit(mask)))
+                    {
+                        return false;
+                    }
+                    mask &= mask - 1;
+                }
+            }
+            return forEachCharSetPositionScalar(str, from, set, visitor);
+        }
+
+
+        /**
+         * AVX2 variant of findCharSetPositionScalar(). Requires set.asciiOnly.
+        */
+        __attribute__((target("avx2")))
+        inline size_t findCharSetPositionAvx2(  const std::string_view & str,
+                                                size_t from,
+                                                const CharSetTables & set,
+                                                const bool members  )
+        {
+            const char * const data = str.data();
+            const size_t length = str.length();
+            const __m256i lowTable = broadcastNibbleTableAvx2(set.lowNibbles);
+            const __m256i highTable = broadcastNibbleTableAvx2(set.highNibbles);
+            const uint32_t flip = members ? 0u : ~0u;
+            for(; from + 32 <= length; from += 32)
+            {
+                uint32_t mask = charSetMembersAvx2(data + from, lowTable, highTable) ^ flip;
+                if(mask != 0)
+                {
+                    return from + lowestSetBit(mask);
+                }
+            }
+            return findCharSetPositionScalar(str, from, set, members);
+        }
+
+
+        /**
+         * AVX2 variant of findLastCharSetPositionScalar(). Requires set.asciiOnly.
+        */
+        __attribute__((target("avx2")))
+        inline size_t findLastCharSetPositionAvx2(  const std::string_view & str,
+                                                    size_t end,
+                                                    const CharSetTables & set,
+                                                    const bool members  )
+        {
+            const char * const data = str.data();
+            const __m256i lowTable = broadcastNibbleTableAvx2(set.lowNibbles);
+            const __m256i highTable = broadcastNibbleTableAvx2(set.highNibbles);
+            const uint32_t flip = members ? 0u : ~0u;
+            for(; end >= 32; end -= 32)
+            {
+                uint32_t mask = charSetMembersAvx2(data + end - 32, lowTable, highTable) ^ flip;
+                if(mask != 0)
+                {
+                    return end - 32 + highestSetBit(mask);
+                }
+            }
+            return findLastCharSetPositionScalar(str, end, set, members);
+        }
+    #endif
+
+
+        /**
+         * Call visitor(index) for every index in str where str[index] is a member of set, in
+         * increasing order, stopping early as soon as visitor returns false. The set-membership
+         * counterpart of forEachCharPosition() - one linear pass no matter how many chars the set
+         * holds, using the AVX2 nibble-shuffle classifier when the CPU and the set allow it.
+         *
+         * @param str - The string to scan.
+         * @param set - The compiled set of chars to look for.
+         * @param visitor - Callable taking a size_t index and returning bool (false to stop).
+         *
+         * @retval bool - False if visitor stopped the scan early, true otherwise.
+        */
+        template<typename Visitor>
+        inline bool forEachCharSetPosition( const std::string_view & str,
+                                            const CharSetTables & set,
+                                            Visitor && visitor  )
+        {
+        #if defined(STEVENSSTRINGLIB_AVX2_DISPATCH)
+            if(set.asciiOnly && cpuSupportsAvx2())
+            {
+                return forEachCharSetPositionAvx2(str, 0, set, visitor);
+            }
+        #endif
+            return forEachCharSetPositionScalar(str, 0, set, visitor);
+        }
+
+
+        /**
+         * Find the first index at or after from where str[index] is a member of set (members true)
+         * or is not (members false) - the CharSet counterpart of find_first_of()/find_first_not_of(),
+         * testing each byte with one table lookup rather than a scan of the set's chars, and 32
+         * bytes at a time with the AVX2 nibble-shuffle classifier when the CPU and the set allow it.
+         *
+         * @param str - The string to scan.
+         * @param from - The index to start scanning at.
+         * @param set - The compiled set of chars.
+         * @param members - True to find a member of set, false to find a non-member.
+         *
+         * @retval size_t - The index found, or std::string_view::npos if there is none.
+        */
+        inline size_t findCharSetPosition(  const std::string_view & str,
+                                            size_t from,
+                                            const CharSetTables & set,
+                                            const bool members  )
+        {
+        #if defined(STEVENSSTRINGLIB_AVX2_DISPATCH)
+            if(set.asciiOnly && cpuSupportsAvx2())
+            {
+                return findCharSetPositionAvx2(str, from, set, members);
+            }
+        #endif
+            return findCharSetPositionScalar(str, from, set, members);
+        }
+
+
+        /**
+         * Backwards counterpart of findCharSetPosition(): the last index before end where
+         * str[index] is a member of set (members true) or is not (members false).
+         *
+         * @retval size_t - The index found, or std::string_view::npos if there is none.
+        */
+        inline size_t findLastCharSetPosition(  const std::string_view & str,
+                                                size_t end,
+                                                const CharSetTables & set,
+                                                const bool members  )
+        {
+            end = std::min(end, str.length());
+        #if defined(STEVENSSTRINGLIB_AVX2_DISPATCH)
+            if(set.asciiOnly && cpuSupportsAvx2())
+            {
+                return findLastCharSetPositionAvx2(str, end, set, members);
+            }
+        #endif
+            return findLastCharSetPositionScalar(str, end, set, members);
+        }
+
+
+        /**
+         * Call visitor(piece) for every piece of str between consecutive separators, in order, with
+         * each piece a std::string_view into str - the piece-walking loop shared by separate(),
+         * separateInto() and friends, so they only differ in where they put the pieces.
+         *
+         * Unlike the public functions, this doesn't special-case an empty str: with
+         * omitEmptyStrings false an empty str is one empty piece, same as an empty stretch between
+         * two separators. Callers that promise "an empty string has no pieces" check that first.
+         *
+         * @param str - The string to separate.
+         * @param separator - The char separating pieces.
+         * @param omitEmptyStrings - If true, empty pieces are skipped.
+         * @param visitor - Callable taking a std::string_view piece.
+        */
+        template<typename Visitor>
+        inline void forEachSeparatedPiece(  const std::string_view & str,
+                                            const char separator,
+                                            const bool omitEmptyStrings,
+                                            Visitor && visitor  )
+        {
+            size_t prevSeparatorIndex = 0;
+            forEachCharPosition(str, separator, [&](size_t currSeparatorIndex)
+            {
+                if(currSeparatorIndex > prevSeparatorIndex || !omitEmptyStrings)
+                {
+                    visitor(str.substr(prevSeparatorIndex, currSeparatorIndex - prevSeparatorIndex));
+                }
+                prevSeparatorIndex = currSeparatorIndex + 1;
+                return true;
+            });
+            //Everything after the last separator up until the end
+            if(prevSeparatorIndex < str.length() || !omitEmptyStrings)
+            {
+                visitor(str.substr(prevSeparatorIndex));
+            }
+        }
+
+
+        /**
+         * forEachSeparatedPiece() variant separating on any char of a compiled CharSet.
+        */
+        template<typename Visitor>
+        inline void forEachSeparatedPiece(  const std::string_view & str,
+                                            const CharSetTables & separators,
+                                            const bool omitEmptyStrings,
+                                            Visitor && visitor  )
+        {
+            size_t prevSeparatorIndex = 0;
+            forEachCharSetPosition(str, separators, [&](size_t currSeparatorIndex)
+            {
+                if(currSeparatorIndex > prevSeparatorIndex || !omitEmptyStrings)
+                {
+                    visitor(str.substr(prevSeparatorIndex, currSeparatorIndex - prevSeparatorIndex));
+                }
+                prevSeparatorIndex = currSeparatorIndex + 1;
+                return true;
+            });
+            if(prevSeparatorIndex < str.length() || !omitEmptyStrings)
+            {
+                visitor(str.substr(prevSeparatorIndex));
+            }
+        }
+
+
+        /**
+         * The piece-walking loop behind separating on a non-empty substring: findSeparator(from)
+         * returns the index of the next occurrence at or after from (or npos), and scanning resumes
+         * right after each occurrence, so occurrences never overlap. Lets a precompiled Searcher
+         * drive the same loop as plain std::string_view::find().
+        */
+        template<typename FindSeparator, typename Visitor>
+        inline void forEachFoundSeparatedPiece( const std::string_view & str,
+                                                const size_t separatorLength,
+                                                FindSeparator && findSeparator,
+                                                const bool omitEmptyStrings,
+                                                Visitor && visitor  )
+        {
+            size_t start = 0;
+            size_t pos = 0;
+            while((pos = findSeparator(start)) != std::string_view::npos)
+            {
+                if(pos > start || !omitEmptyStrings)
+                {
+                    visitor(str.substr(start, pos - start));
+                }
+                start = pos + separatorLength;
+            }
+            if(start < str.length() || !omitEmptyStrings)
+            {
+                visitor(str.substr(start));
+            }
+        }
+
+
+        /**
+         * The scanning loops behind separateN(). Push at most maxPieces pieces of str onto pieces,
+         * in the order they appear in str, and return where the unscanned remainder starts (from
+         * the left) or ends (from the right). findSeparator(from) returns the index of the next
+         * separator at or after from, and findSeparatorBefore(end) the index of the last separator
+         * that ends at or before end - either returns npos if there's none.
+        */
+        template<typename FindSeparator>
+        inline size_t separateNFromLeft(    const std::string_view & str,
+                                            const size_t separatorLength,
+                                            FindSeparator && findSeparator,
+                                            const size_t maxPieces,
+                                            const bool omitEmptyStrings,
+                                            std::vector<std::string_view> & pieces  )
+        {
+            size_t start = 0;
+            while(pieces.size() < maxPieces)
+            {
+                size_t pos = findSeparator(start);
+                if(pos == std::string_view::npos)
+                {
+                    //No separator left, so everything up until the end is the last piece
+                    if(start < str.length() || !omitEmptyStrings)
+                    {
+                        pieces.push_back(str.substr(start));
+                    }
+                    return str.length();
+                }
+                if(pos > start || !omitEmptyStrings)
+                {
+                    pieces.push_back(str.substr(start, pos - start));
+                }
+                start = pos + separatorLength;
+            }
+            return start;
+        }
+
+        template<typename FindSeparatorBefore>
+        inline size_t separateNFromRight(   const std::string_view & str,
+                                            const size_t separatorLength,
+                                            FindSeparatorBefore && findSeparatorBefore,
+                                            const size_t maxPieces,
+                                            const bool omitEmptyStrings,
+                                            std::vector<std::string_view> & pieces  )
+        {
+            size_t end = str.length();
+            while(pieces.size() < maxPieces)
+            {
+                size_t pos = findSeparatorBefore(end);
+                if(pos == std::string_view::npos)
+                {
+                    //No separator left, so everything from the start is the last piece
+                    if(end > 0 || !omitEmptyStrings)
+                    {
+                        pieces.push_back(str.substr(0, end));
+                    }
+                    end = 0;
+                    break;
+                }
+                size_t pieceStart = pos + separatorLength;
+                if(end > pieceStart || !omitEmptyStrings)
+                {
+                    pieces.push_back(str.substr(pieceStart, end - pieceStart));
+                }
+                end = pos;
+            }
+            //Pieces were collected back to front
+            std::reverse(pieces.begin(), pieces.end());
+            return end;
+        }
+
+
+        /**
+         * forEachSeparatedPiece() variant separating on a substring. A one-char separator takes the
+         * char path, and an empty separator yields every codepoint of str as its own piece (see
+         * separate() for why codepoints rather than bytes).
+        */
+        template<typename Visitor>
+        inline void forEachSeparatedPiece(  const std::string_view & str,
+                                            const std::string_view & separator,
+                                            const bool omitEmptyStrings,
+                                            Visitor && visitor  )
+        {
+            if(separator.length() == 1)
+            {
+                forEachSeparatedPiece(str, separator[0], omitEmptyStrings, visitor);
+                return;
+            }
+
+            if(separator.empty())
+            {
+                forEachCodepoint(str, visitor);
+                return;
+            }
+
+            forEachFoundSeparatedPiece( str,
+                                        separator.length(),
+                                        [&](size_t from) { return str.find(separator, from); },
+                                        omitEmptyStrings,
+                                        visitor );
+        }
+
+
+        /**
+         * Store piece as element index of out, for separateInto(). An element that already exists
+         * is overwritten in place - for std::string elements that's assign(), which reuses the
+         * string's existing buffer whenever the piece fits - and anything past the end is appended.
+        */
+        inline void storePiece(std::vector<std::string> & out, size_t index, const std::string_view & piece)
+        {
+            if(index < out.size())
+            {
+                out[index].assign(piece.data(), piece.size());
+            }
+            else
+            {
+                out.emplace_back(piece);
+            }
+        }
+
+        inline void storePiece(std::vector<std::string_view> & out, size_t index, const std::string_view & piece)
+        {
+            if(index < out.size())
+            {
+                out[index] = piece;
+            }
+            else
+            {
+                out.push_back(piece);
+            }
+        }
+
+
+        /**
+         * How many chunks (and so worker threads) to split length bytes of input into for the
+         * parallel variants of this library's functions: one per thread, but never so many that a
+         * chunk drops below minChunkSize bytes - below that, starting a thread costs more than the
+         * work it would take over. A threadCount of 0 means one per hardware thread.
+         *
+         * @retval size_t - The number of chunks, at least 1.
+        */
+        inline size_t parallelChunkCount(size_t length, unsigned int threadCount, size_t minChunkSize)
+        {
+            size_t threads = (threadCount == 0) ? std::thread::hardware_concurrency() : threadCount;
+            size_t chunksBySize = length / std::max<size_t>(minChunkSize, 1);
+            return std::max<size_t>(1, std::min(std::max<size_t>(threads, 1), chunksBySize));
+        }
+
+
+        /**
+         * Run task(0) through task(taskCount - 1), each on its own thread (task 0 on the calling
+         * thread), and wait for them all. If the system runs out of threads partway, the tasks
+         * left over run on the calling thread too. If any task throws, the first exception (by
+         * task index) is rethrown here once every thread has been joined.
+         *
+         * @param taskCount - The number of tasks to run.
+         * @param task - Callable taking the size_t index of the task to run.
+        */
+        template<typename Task>
+        inline void runInParallel(size_t taskCount, Task && task)
+        {
+            std::vector<std::exception_ptr> errors(taskCount);
+            auto runTask = [&](size_t index)
+            {
+                try
+                {
+                    task(index);
+                }
+                catch(...)
+                {
+                    errors[index] = std::current_exception();
+                }
+            };
+
+            std::vector<std::thread> workers;
+            workers.reserve(taskCount);
+            //If a thread can't be started (std::system_error, or std::bad_alloc for its state), the
+            //tasks still without one run here instead - the threads already started must be
+            //joined either way, or destroying them would call std::terminate()
+            size_t firstUnstarted = std::max<size_t>(taskCount, 1);
+            try
+            {
+                for(size_t index = 1; index < taskCount; index++)
+                {
+                    workers.emplace_back(runTask, index);
+                }
+            }
+            catch(...)
+            {
+                firstUnstarted = workers.size() + 1;
+            }
+            if(taskCount > 0)
+            {
+                runTask(0);
+            }
+            for(size_t index = firstUnstarted; index < taskCount; index++)
+            {
+                runTask(index);
+            }
+            for(std::thread & worker : workers)
+            {
+                worker.join();
+            }
+
+            for(const std::exception_ptr & error : errors)
+            {
+                if(error)
+                {
+                    std::rethrow_exception(error);
+                }
+            }
+        }
+
+
+        /**
+         * The shared body of the parallel separate() variants. Cuts str into chunkCount chunks,
+         * each ending right where a separator starts - findSeparator(from) returns the
+         * [start, end) byte range of a separator occurrence at or after from that separate() would
+         * also split on, or npos - so every chunk holds whole pieces. The chunks are separated on
+         * worker threads with forEachSeparatedPiece() (via separateChunk(chunk, visitor)), then
+         * moved into one result vector in order, again in parallel.
+         *
+         * Because a chunk ends exactly at a separator, splitting it on its own yields exactly the
+         * pieces a serial pass yields for that stretch - including the empty piece of a chunk that
+         * falls between two adjacent separators, which forEachSeparatedPiece() produces just like
+         * any other empty piece when omitEmptyStrings is false.
+        */
+        template<typename FindSeparator, typename SeparateChunk>
+        inline std::vector<std::string> separateInChunks(   const std::string_view & str,
+                                                            size_t chunkCount,
+                                                            FindSeparator && findSeparator,
+                                                            SeparateChunk && separateChunk  )
+        {
+            //Pick the chunk boundaries, each at the first usable separator after an even split point
+            std::vector<std::string_view> chunks;
+            size_t chunkStart = 0;
+            for(size_t chunk = 1; chunk < chunkCount; chunk++)
+            {
+                size_t target = std::max(chunkStart, str.length() / chunkCount * chunk);
+                std::pair<size_t, size_t> separator = findSeparator(target, chunkStart);
+                if(separator.first == std::string_view::npos)
+                {
+                    break;
+                }
+                chunks.push_back(str.substr(chunkStart, separator.first - chunkStart));
+                chunkStart = separator.second;
+            }
+            chunks.push_back(str.substr(chunkStart));
+
+            //Separate every chunk on its own thread
+            std::vector<std::vector<std::string>> chunkPieces(chunks.size());
+            runInParallel(chunks.size(), [&](size_t chunk)
+            {
+                separateChunk(chunks[chunk], [&](const std::string_view & piece)
+                {
+                    chunkPieces[chunk].emplace_back(piece);
+                });
+            });
+
+            //Stitch the pieces back together in order - each thread moves its own chunk's pieces
+            //into their final slots
+            std::vector<size_t> offsets(chunks.size() + 1, 0);
+            for(size_t chunk = 0; chunk < chunks.size(); chunk++)
+            {
+                offsets[chunk + 1] = offsets[chunk] + chunkPieces[chunk].size();
+            }
+            std::vector<std::string> separatedStrings(offsets.back());
+            runInParallel(chunks.size(), [&](size_t chunk)
+            {
+                std::move(chunkPieces[chunk].begin(), chunkPieces[chunk].end(),
+                          separatedStrings.begin() + offsets[chunk]);
+            });
+            return separatedStrings;
+        }
+
+
+        /**
+         * The shared body of the parallel findAll() variants. Cuts str into chunkCount even chunks
+         * of start positions, and on its own thread finds every occurrence starting in each chunk -
+         * searching needleLength - 1 bytes past the chunk's end, so an occurrence straddling the
+         * border is found by the chunk it starts in. find(haystack, from) is the search to use.
+         *
+         * With overlapping false, where the serial scan resumes depends on the occurrence before,
+         * so a chunk scanned from its own start can disagree with it near the start. Chunks are
+         * then fixed up in order: if the previous chunk's last occurrence runs past this chunk's
+         * start, the serial scan is replayed from its end until it lands on an occurrence this
+         * chunk already found - from there on the two scans agree - and only the replayed
+         * occurrences replace the ones before it.
+         *
+         * @retval std::vector<size_t> - Every occurrence's index, in increasing order.
+        */
+        template<typename Find>
+        inline std::vector<size_t> findAllInChunks( const std::string_view & str,
+                                                    size_t needleLength,
+                                                    bool overlapping,
+                                                    size_t chunkCount,
+                                                    Find && find  )
+        {
+            const size_t step = overlapping ? 1 : needleLength;
+            const size_t chunkLength = str.length() / chunkCount;
+            auto chunkWindow = [&](size_t chunk)
+            {
+                size_t begin = chunk * chunkLength;
+                size_t end = (chunk + 1 == chunkCount) ? str.length() : begin + chunkLength;
+                return std::make_pair(begin, str.substr(begin, end - begin + needleLength - 1));
+            };
+
+            //Find every occurrence starting in each chunk on its own thread
+            std::vector<std::vector<size_t>> chunkPositions(chunkCount);
+            runInParallel(chunkCount, [&](size_t chunk)
+            {
+                const std::pair<size_t, std::string_view> window = chunkWindow(chunk);
+                size_t pos = find(window.second, 0);
+                while(pos != std::string_view::npos)
+                {
+                    chunkPositions[chunk].push_back(window.first + pos);
+                    pos = find(window.second, pos + step);
+                }
+            });
+
+            //Without overlaps, replay the serial scan wherever a chunk's start disagrees with it
+            std::vector<std::vector<size_t>> replayed(chunkCount);
+            std::vector<size_t> keepFrom(chunkCount, 0);
+            if(!overlapping)
+            {
+                size_t resumeAt = 0;
+                for(size_t chunk = 0; chunk < chunkCount; chunk++)
+                {
+                    const std::pair<size_t, std::string_view> window = chunkWindow(chunk);
+                    const std::vector<size_t> & positions = chunkPositions[chunk];
+                    keepFrom[chunk] = positions.size();
+                    if(resumeAt <= window.first)
+                    {
+                        keepFrom[chunk] = 0;
+                    }
+                    else
+                    {
+                        size_t pos = find(window.second, resumeAt - window.first);
+                        while(pos != std::string_view::npos)
+                        {
+                            auto found = std::lower_bound(positions.begin(), positions.end(), window.first + pos);
+                            if(found != positions.end() && *found == window.first + pos)
+                            {
+                                keepFrom[chunk] = static_cast<size_t>(found - positions.begin());
+                                break;
+                            }
+                            replayed[chunk].push_back(window.first + pos);
+                            pos = find(window.second, pos + step);
+                        }
+                    }
+                    if(keepFrom[chunk] < positions.size())
+                    {
+                        resumeAt = positions.back() + needleLength;
+                    }
+                    else if(!replayed[chunk].empty())
+                    {
+                        resumeAt = replayed[chunk].back() + needleLength;
+                    }
+                }
+            }
+
+            //Stitch the chunks' positions together in order, each thread copying its own chunk's
+            std::vector<size_t> offsets(chunkCount + 1, 0);
+            for(size_t chunk = 0; chunk < chunkCount; chunk++)
+            {
+                offsets[chunk + 1] = offsets[chunk] + replayed[chunk].size()
+                                     + (chunkPositions[chunk].size() - keepFrom[chunk]);
+            }
+            std::vector<size_t> positions(offsets.back());
+            runInParallel(chunkCount, [&](size_t chunk)
+            {
+                auto out = std::copy(replayed[chunk].begin(), replayed[chunk].end(), positions.begin() + offsets[chunk]);
+                std::copy(chunkPositions[chunk].begin() + keepFrom[chunk], chunkPositions[chunk].end(), out);
+            });
+            return positions;
+        }
+
+
+        /**
+         * Bitmasks over one 64-byte block of CSV text: bit i of quotes is set if block[i] is a
+         * double quote, and bit i of separators is set if block[i] is the delimiter or a newline.
+        */
+        struct CsvBlockMasks
+        {
+            uint64_t quotes;
+            uint64_t separators;
+        };
+
+
+        /**
+         * Build the CsvBlockMasks of the 64 bytes starting at block - with SSE2, four 16-byte
+         * compare + movemask rounds (the same scan forEachCharPosition() does, against three
+         * chars at once), otherwise one byte at a time.
+        */
+        inline CsvBlockMasks csvBlockMasks(const char * block, const char delimiter)
+        {
+            CsvBlockMasks masks = {0, 0};
+        #if defined(STEVENSSTRINGLIB_X86_SIMD)
+            const __m128i quote = _mm_set1_epi8('"');
+            const __m128i delim = _mm_set1_epi8(delimiter);
+            const __m128i newline = _mm_set1_epi8('\n');
+            for(unsigned int offset = 0; offset < 64; offset += 16)
+            {
+                __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + offset));
+                uint64_t quoteBits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, quote)));
+                uint64_t separatorBits = static_cast<uint32_t>(_mm_movemask_epi8(
+                    _mm_or_si128(_mm_cmpeq_epi8(bytes, delim), _mm_cmpeq_epi8(bytes, newline))));
+                masks.quotes |= quoteBits << offset;
+                masks.separators |= separatorBits << offset;
+            }
+        #else
+            for(unsigned int offset = 0; offset < 64; offset++)
+            {
+                const char ch = block[offset];
+                masks.quotes |= static_cast<uint64_t>(ch == '"') << offset;
+                masks.separators |= static_cast<uint64_t>(ch == delimiter || ch == '\n') << offset;
+            }
+        #endif
+            return masks;
+        }
+
+
+        /**
+         * Prefix XOR of a 64-bit mask: bit i of the result is the XOR of bits 0..i of mask. Applied
+         * to a quote mask, it sets exactly the bits that lie inside a quoted span (opening quote
+         * included, closing quote excluded). An escaped quote ("") toggles twice and so leaves the
+         * span open, just as RFC 4180 intends.
+        */
+        inline uint64_t prefixXor(uint64_t mask)
+        {
+            mask ^= mask << 1;
+            mask ^= mask << 2;
+            mask ^= mask << 4;
+            mask ^= mask << 8;
+            mask ^= mask << 16;
+            mask ^= mask << 32;
+            return mask;
+        }
+
+
+        /**
+         * Call visitor(index) for every index of csv holding a delimiter or newline that is not
+         * inside a quoted field, in increasing order, stopping early if visitor returns false.
+         * Works 64 bytes at a time: the block's quote mask is turned into an inside-quotes mask by
+         * prefixXor() (carrying the state over from the previous block), and the delimiters and
+         * newlines under it are masked out - so quoting costs no per-byte branching at all.
+         *
+         * @retval bool - False if visitor stopped the scan early, true otherwise.
+        */
+        template<typename Visitor>
+        inline bool forEachCsvStructuralPosition(   const std::string_view & csv,
+                                                    const char delimiter,
+                                                    Visitor && visitor  )
+        {
+            const char * const data = csv.data();
+            const size_t length = csv.length();
+            uint64_t insideQuotes = 0; // all ones while the previous block ended inside quotes
+            char tail[64];
+            for(size_t blockStart = 0; blockStart < length; blockStart += 64)
+            {
+                const char * block = data + blockStart;
+                uint64_t validBits = ~static_cast<uint64_t>(0);
+                if(length - blockStart < 64)
+                {
+                    //Copy the final partial block into a zero-padded buffer instead of reading past the end
+                    std::memset(tail, 0, sizeof(tail));
+                    std::memcpy(tail, block, length - blockStart);
+                    block = tail;
+                    validBits = (static_cast<uint64_t>(1) << (length - blockStart)) - 1;
+                }
+
+                CsvBlockMasks masks = csvBlockMasks(block, delimiter);
+                uint64_t inside = prefixXor(masks.quotes) ^ insideQuotes;
+                insideQuotes = static_cast<uint64_t>(0) - (inside >> 63);
+                uint64_t structural = masks.separators & ~inside & validBits;
+                while(structural != 0)
+                {
+                    if(!visitor(blockStart + lowestSetBit(structural)))
+                    {
+                        return false;
+                    }
+                    structural &= structural - 1; // clear the bit we just visited
+                }
+            }
+            return true;
+        }
+
+
+        /**
+         * The shared body of the streaming forEachToken() variants. Reads the input through one
+         * reusable buffer - readChunk(destination, maxBytes) fills in up to maxBytes and returns how
+         * many it read, 0 at the end of the input - and after every read hands the buffered text to
+         * separateComplete(text, newBytesStart, visitor). That calls visitor for each piece that is
+         * known to be complete (i.e. followed by a separator) and returns how many bytes it used
+         * up; the rest is the start of a piece still being read, so it's moved to the front of the
+         * buffer and picked up again after the next read. Everything before newBytesStart has
+         * already been scanned without finding a separator, so separateComplete only needs to look
+         * at the bytes just read - a long piece read in many small reads isn't rescanned after
+         * each one. The buffer only grows when a single piece doesn't fit in it.
+        */
+        template<typename ReadChunk, typename SeparateComplete, typename Visitor>
+        inline void forEachBufferedPiece(   ReadChunk && readChunk,
+                                            size_t bufferSize,
+                                            const bool omitEmptyStrings,
+                                            SeparateComplete && separateComplete,
+                                            Visitor && visitor  )
+        {
+            std::string buffer(std::max<size_t>(bufferSize, 1), '\0');
+            size_t filled = 0;
+            bool sawInput = false;
+            while(true)
+            {
+                if(filled == buffer.size())
+                {
+                    //One piece has outgrown the buffer
+                    buffer.resize(buffer.size() * 2);
+                }
+                size_t bytesRead = readChunk(&buffer[filled], buffer.size() - filled);
+                if(bytesRead == 0)
+                {
+                    break;
+                }
+                sawInput = true;
+                const size_t newBytesStart = filled;
+                filled += bytesRead;
+
+                size_t consumed = separateComplete(std::string_view(buffer.data(), filled), newBytesStart, visitor);
+                std::memmove(&buffer[0], buffer.data() + consumed, filled - consumed);
+                filled -= consumed;
+            }
+            //Whatever is left is the last piece, which no separator follows
+            if(sawInput && (filled > 0 || !omitEmptyStrings))
+            {
+                visitor(std::string_view(buffer.data(), filled));
+            }
+        }
+
+
+        /**
+         * Stream readers for forEachBufferedPiece(): one pulling from a std::istream, one from a
+         * POSIX file descriptor (retrying reads interrupted by signals, throwing on real errors).
+        */
+        inline size_t readChunk(std::istream & input, char * destination, size_t maxBytes)
+        {
+            //Take whatever is already buffered, and only block (for a single char) when nothing
+            //is, so tokens arriving on a pipe or terminal are handed out as soon as they're complete
+            std::streamsize bytesRead = input.readsome(destination, static_cast<std::streamsize>(maxBytes));
+            if(bytesRead > 0)
+            {
+                return static_cast<size_t>(bytesRead);
+            }
+            const std::istream::int_type ch = input.get();
+            if(ch == std::istream::traits_type::eof())
+            {
+                return 0;
+            }
+            destination[0] = std::istream::traits_type::to_char_type(ch);
+            bytesRead = (maxBytes > 1) ? input.readsome(destination + 1, static_cast<std::streamsize>(maxBytes - 1)) : 0;
+            return 1 + static_cast<size_t>(bytesRead);
+        }
+
+    #if defined(STEVENSSTRINGLIB_POSIX_IO)
+        inline size_t readChunk(int fileDescriptor, char * destination, size_t maxBytes)
+        {
+            while(true)
+            {
+                ssize_t bytesRead = ::read(fileDescriptor, destination, maxBytes);
+                if(bytesRead >= 0)
+                {
+                    return static_cast<size_t>(bytesRead);
+                }
+                if(errno != EINTR)
+                {
+                    throw std::system_error(errno, std::generic_category(), "Error reading from file descriptor");
+                }
+            }
+        }
+    #endif
+
+
+        /**
+         * forEachBufferedPiece() over any stream readChunk() accepts, separating on a char: the
+         * complete pieces of each buffer are everything up to its last separator, which the
+         * regular forEachSeparatedPiece() scan walks.
+        */
+        template<typename Stream, typename Visitor>
+        inline void forEachStreamedPiece(   Stream && stream,
+                                            const char separator,
+                                            const bool omitEmptyStrings,
+                                            size_t bufferSize,
+                                            Visitor && visitor  )
+        {
+            auto separateComplete = [&](const std::string_view & text, size_t newBytesStart, auto & pieceVisitor) -> size_t
+            {
+                size_t lastSeparatorIndex = text.substr(newBytesStart).rfind(separator);
+                if(lastSeparatorIndex == std::string_view::npos)
+                {
+                    return 0;
+                }
+                lastSeparatorIndex += newBytesStart;
+                forEachSeparatedPiece(text.substr(0, lastSeparatorIndex), separator, omitEmptyStrings, pieceVisitor);
+                return lastSeparatorIndex + 1;
+            };
+            forEachBufferedPiece(   [&](char * destination, size_t maxBytes)
+                                    {
+                                        return readChunk(stream, destination, maxBytes);
+                                    },
+                                    bufferSize, omitEmptyStrings, separateComplete, visitor );
+        }
+
+
+        /**
+         * forEachBufferedPiece() over any stream readChunk() accepts, separating on a non-empty
+         * substring. The buffer is scanned left to right exactly like separate() does, and what's
+         * left after the last match - where separate() would resume scanning - is carried over, so
+         * even a separator that can overlap itself splits the same way it would in memory.
+        */
+        template<typename Stream, typename Visitor>
+        inline void forEachStreamedPiece(   Stream && stream,
+                                            const std::string_view & separator,
+                                            const bool omitEmptyStrings,
+                                            size_t bufferSize,
+                                            Visitor && visitor  )
+        {
+            auto separateComplete = [&](const std::string_view & text, size_t newBytesStart, auto & pieceVisitor) -> size_t
+            {
+                size_t start = 0;
+                //The carried-over bytes hold no whole separator, but one may end in the new bytes
+                size_t pos = text.find(separator, (newBytesStart >= separator.length()) ? newBytesStart - separator.length() + 1 : 0);
+                for(; pos != std::string_view::npos; pos = text.find(separator, start))
+                {
+                    if(pos > start || !omitEmptyStrings)
+                    {
+                        pieceVisitor(text.substr(start, pos - start));
+                    }
+                    start = pos + separator.length();
+                }
+                return start;
+            };
+            forEachBufferedPiece(   [&](char * destination, size_t maxBytes)
+                                    {
+                                        return readChunk(stream, destination, maxBytes);
+                                    },
+                                    bufferSize, omitEmptyStrings, separateComplete, visitor );
+        }
+
+
+    #if defined(STEVENSSTRINGLIB_X86_SIMD)
+        /**
+         * Index of the first occurrence of needle (at least 2 chars) in haystack at or after from,
+         * or npos. Compares 16 candidate positions at a time against needle's first and last
+         * chars at once (one load at the candidate, one needle.length() - 1 bytes further), and
+         * only runs a full memcmp on the candidates where both match - which on real text is a
+         * tiny fraction, even when the first char alone is common (like the ' ' of " and ").
+        */
+        inline size_t findSubstringSse2(    const std::string_view & haystack,
+                                            size_t from,
+                                            const std::string_view & needle )
+        {
+            const char * const data = haystack.data();
+            const size_t lastOffset = needle.length() - 1;
+            const __m128i firstChar = _mm_set1_epi8(needle[0]);
+            const __m128i lastChar = _mm_set1_epi8(needle[lastOffset]);
+            for(; from + lastOffset + 16 <= haystack.length(); from += 16)
+            {
+                __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + from));
+                __m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + from + lastOffset));
+                uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(
+                    _mm_and_si128(_mm_cmpeq_epi8(blockFirst, firstChar), _mm_cmpeq_epi8(blockLast, lastChar))));
+                while(mask != 0)
+                {
+                    size_t candidate = from + lowestSetBit(mask);
+                    if(std::memcmp(data + candidate + 1, needle.data() + 1, lastOffset - 1) == 0)
+                    {
+                        return candidate;
+                    }
+                    mask &= mask - 1;
+                }
+            }
+            return haystack.find(needle, from);
+        }
+    #endif
+
+
+    #if defined(STEVENSSTRINGLIB_AVX2_DISPATCH)
+        /**
+         * AVX2 variant of findSubstringSse2() - the same first-and-last-char filter, 32 candidate
+         * positions at a time. Only called after cpuSupportsAvx2() says it's safe.
+        */
+        __attribute__((target("avx2")))
+        inline size_t findSubstringAvx2(    const std::string_view & haystack,
+                                            size_t from,
+                                            const std::string_view & needle )
+        {
+            const char * const data = haystack.data();
+            const size_t lastOffset = needle.length() - 1;
+            const __m256i firstChar = _mm256_set1_epi8(needle[0]);
+            const __m256i lastChar = _mm256_set1_epi8(needle[lastOffset]);
+            for(; from + lastOffset + 32 <= haystack.length(); from += 32)
+            {
+                __m256i blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + from));
+                __m256i blockLast = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + from + lastOffset));
+                __m256i bothMatch = _mm256_and_si256(   _mm256_cmpeq_epi8(blockFirst, firstChar),
+                                                        _mm256_cmpeq_epi8(blockLast, lastChar)  );
+                uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(bothMatch));
+                while(mask != 0)
+                {
+                    size_t candidate = from + lowestSetBit(mask);
+                    if(std::memcmp(data + candidate + 1, needle.data() + 1, lastOffset - 1) == 0)
+                    {
+                        return candidate;
+                    }
+                    mask &= mask - 1;
+                }
+            }
+            return findSubstringSse2(haystack, from, needle);
+        }
+    #endif
+
+
+        /**
+         * findSubstringSse2() for a separator fixed at compile time (see separate<Separator...>()):
+         * the first/last char broadcasts are constants, and each candidate is checked with one
+         * unrolled compare per char instead of a memcmp call. Index of the first occurrence of the
+         * separator in str at or after from, or npos.
+        */
+        template<char... Separator>
+        inline size_t findFixedSeparator(const std::string_view & str, size_t from)
+        {
+            constexpr size_t lastOffset = sizeof...(Separator) - 1;
+            const char * const data = str.data();
+            const size_t length = str.length();
+            auto matchesAt = [data](size_t index)
+            {
+                size_t offset = 0;
+                return ((data[index + offset++] == Separator) && ...);
+            };
+
+        #if defined(STEVENSSTRINGLIB_X86_SIMD)
+            constexpr char separator[] = {Separator...};
+            const __m128i firstChar = _mm_set1_epi8(separator[0]);
+            const __m128i lastChar = _mm_set1_epi8(separator[lastOffset]);
+            for(; from + lastOffset + 16 <= length; from += 16)
+            {
+                __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + from));
+                __m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + from + lastOffset));
+                uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(
+                    _mm_and_si128(_mm_cmpeq_epi8(blockFirst, firstChar), _mm_cmpeq_epi8(blockLast, lastChar))));
+                while(mask != 0)
+                {
+                    size_t candidate = from + lowestSetBit(mask);
+                    if(matchesAt(candidate))
+                    {
+                        return candidate;
+                    }
+                    mask &= mask - 1;
+                }
+            }
+        #endif
+            for(; from + lastOffset < length; from++)
+            {
+                if(matchesAt(from))
+                {
+                    return from;
+                }
+            }
+            return std::string_view::npos;
+        }
+
+
+        /**
+         * ASCII lowercase of one byte: 'A'..'Z' become 'a'..'z', and every other byte (including
+         * each byte of a multi-byte UTF-8 character) is left as it is.
+        */
+        inline unsigned char asciiFoldByte(unsigned char byte)
+        {
+            return (static_cast<unsigned int>(byte - 'A') < 26u) ? static_cast<unsigned char>(byte | 0x20) : byte;
+        }
+
+
+        /**
+         * Whether the count bytes at a and b are equal once both are ASCII-lowercased with
+         * asciiFoldByte(). Portable fallback behind equalsAsciiIgnoreCase().
+        */
+        inline bool equalsAsciiIgnoreCaseScalar(const char * a, const char * b, size_t count)
+        {
+            for(size_t index = 0; index < count; index++)
+            {
+                if(asciiFoldByte(static_cast<unsigned char>(a[index])) != asciiFoldByte(static_cast<unsigned char>(b[index])))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+
+    #if defined(STEVENSSTRINGLIB_X86_SIMD)
+        /**
+         * asciiFoldByte() on 16 bytes at once, with no lookups: adding 0x80 - 'A' moves 'A'..'Z' to
+         * the 26 lowest signed byte values, one signed compare flags exactly those, and OR-ing 0x20
+         * in under that mask lowercases them.
+        */
+        inline __m128i asciiFoldSse2(__m128i block)
+        {
+            const __m128i shifted = _mm_add_epi8(block, _mm_set1_epi8(static_cast<char>(0x80 - 'A')));
+            const __m128i isUpper = _mm_cmplt_epi8(shifted, _mm_set1_epi8(static_cast<char>(0x80 + 26)));
+            return _mm_or_si128(block, _mm_and_si128(isUpper, _mm_set1_epi8(0x20)));
+        }
+    #endif
+
+
+        /**
+         * Whether the count bytes at a and b are equal once both are ASCII-lowercased - 16 bytes
+         * at a time with asciiFoldSse2() on x86-64.
+        */
+        inline bool equalsAsciiIgnoreCase(const char * a, const char * b, size_t count)
+        {
+            size_t index = 0;
+        #if defined(STEVENSSTRINGLIB_X86_SIMD)
+            for(; index + 16 <= count; index += 16)
+            {
+                __m128i blockA = asciiFoldSse2(_mm_loadu_si128(reinterpret_cast<const __m128i *>(a + index)));
+                __m128i blockB = asciiFoldSse2(_mm_loadu_si128(reinterpret_cast<const __m128i *>(b + index)));
+                if(_mm_movemask_epi8(_mm_cmpeq_epi8(blockA, blockB)) != 0xFFFF)
+                {
+                    return false;
+                }
+            }
+        #endif
+            return equalsAsciiIgnoreCaseScalar(a + index, b + index, count - index);
+        }
+
+
+        /**
+         * Index of the first occurrence of needle (at least 1 char) in haystack at or after from,
+         * ignoring ASCII case, or npos. Portable fallback behind findAsciiIgnoreCase().
+        */
+        inline size_t findAsciiIgnoreCaseScalar(    const std::string_view & haystack,
+                                                    size_t from,
+                                                    const std::string_view & needle )
+        {
+            const unsigned char firstChar = asciiFoldByte(static_cast<unsigned char>(needle[0]));
+            for(; from + needle.length() <= haystack.length(); from++)
+            {
+                if(asciiFoldByte(static_cast<unsigned char>(haystack[from])) == firstChar
+                   && equalsAsciiIgnoreCase(haystack.data() + from + 1, needle.data() + 1, needle.length() - 1))
+                {
+                    return from;
+                }
+            }
+            return std::string_view::npos;
+        }
+
+
+    #if defined(STEVENSSTRINGLIB_X86_SIMD)
+        /**
+         * SSE2 variant of findAsciiIgnoreCaseScalar(): findSubstringSse2()'s first-and-last-char
+         * filter, run on case-folded blocks, so the full comparison only happens at candidates
+         * whose first and last chars already match regardless of case.
+        */
+        inline size_t findAsciiIgnoreCaseSse2(  const std::string_view & haystack,
+                                                size_t from,
+                                                const std::string_view & needle )
+        {
+            const char * const data = haystack.data();
+            const size_t lastOffset = needle.length() - 1;
+            const __m128i firstChar = _mm_set1_epi8(static_cast<char>(asciiFoldByte(static_cast<unsigned char>(needle[0]))));
+            const __m128i lastChar = _mm_set1_epi8(static_cast<char>(asciiFoldByte(static_cast<unsigned char>(needle[lastOffset]))));
+            for(; from + lastOffset + 16 <= haystack.length(); from += 16)
+            {
+                __m128i blockFirst = asciiFoldSse2(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + from)));
+                __m128i blockLast = asciiFoldSse2(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + from + lastOffset)));
+                uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(
+                    _mm_and_si128(_mm_cmpeq_epi8(blockFirst, firstChar), _mm_cmpeq_epi8(blockLast, lastChar))));
+                while(mask != 0)
+                {
+                    size_t candidate = from + lowestSetBit(mask);
+                    if(equalsAsciiIgnoreCase(data + candidate, needle.data(), lastOffset))
+                    {
+                        return candidate;
+                    }
+                    mask &= mask - 1;
+                }
+            }
+            return findAsciiIgnoreCaseScalar(haystack, from, needle);
+        }
+    #endif
+
+
+        /**
+         * Index of the first occurrence of needle in haystack at or after from, ignoring ASCII
+         * case, or npos - the same result as find() on toLower() copies of both, without making
+         * the copies. Same result as find() for an empty needle.
+        */
+        inline size_t findAsciiIgnoreCase(  const std::string_view & haystack,
+                                            size_t from,
+                                            const std::string_view & needle )
+        {
+            if(needle.empty())
+            {
+                return (from <= haystack.length()) ? from : std::string_view::npos;
+            }
+            if(from > haystack.length())
+            {
+                return std::string_view::npos;
+            }
+        #if defined(STEVENSSTRINGLIB_X86_SIMD)
+            return findAsciiIgnoreCaseSse2(haystack, from, needle);
+        #else
+            return findAsciiIgnoreCaseScalar(haystack, from, needle);
+        #endif
+        }
+
+
+        /**
+         * The UTF-8 fallback of the case-insensitive functions: compares str, from index from on,
+         * with needle a codepoint at a time under utf8proc's simple lowercase mapping
+         * (utf8proc_tolower()), which maps each codepoint to exactly one codepoint - but not always
+         * one of the same byte length (e.g. KELVIN SIGN to 'k'), so matches are measured in str's
+         * own bytes. Throws utf8::invalid_utf8 if either string is malformed.
+         *
+         * @retval size_t - The index in str just past the match if str continues with needle, npos if not.
+        */
+        inline size_t matchFoldedCodepoints(    const std::string_view & str,
+                                                size_t from,
+                                                const std::string_view & needle )
+        {
+            auto strIt = str.begin() + from;
+            auto needleIt = needle.begin();
+            while(needleIt != needle.end())
+            {
+                if(strIt == str.end())
+                {
+                    return std::string_view::npos;
+                }
+                utf8::utfchar32_t strCodepoint = utf8::next(strIt, str.end());
+                utf8::utfchar32_t needleCodepoint = utf8::next(needleIt, needle.end());
+                if(utf8proc_tolower(static_cast<utf8proc_int32_t>(strCodepoint))
+                   != utf8proc_tolower(static_cast<utf8proc_int32_t>(needleCodepoint)))
+                {
+                    return std::string_view::npos;
+                }
+            }
+            return static_cast<size_t>(strIt - str.begin());
+        }
+
+
+        /**
+         * Index of the first codepoint boundary of str at or after from where
+         * matchFoldedCodepoints() finds needle, or npos. from must be a codepoint boundary.
+        */
+        inline size_t findFoldedCodepoints( const std::string_view & str,
+                                            size_t from,
+                                            const std::string_view & needle )
+        {
+            while(from <= str.length())
+            {
+                if(matchFoldedCodepoints(str, from, needle) != std::string_view::npos)
+                {
+                    return from;
+                }
+                //Step to the next codepoint boundary, past any UTF-8 continuation bytes
+                do
+                {
+                    from++;
+                }
+                while(from < str.length() && (static_cast<unsigned char>(str[from]) & 0xC0) == 0x80);
+            }
+            return std::string_view::npos;
+        }
+
+
+        /**
+         * Whether str is plain ASCII, in which case the case-insensitive functions can fold it a
+         * byte at a time with SIMD rather than decoding it.
+        */
+        inline bool isAscii(const std::string_view & str)
+        {
+            return asciiRunEnd(str, 0) == str.length();
+        }
+
+
+        /**
+         * Call visitor(args...) and report whether it wants to keep going - for public visitor
+         * APIs that accept both plain callbacks (returning void, never stop) and ones that return
+         * bool (false to stop early).
+         *
+         * @retval bool - False if visitor returned false, true otherwise.
+        */
+        template<typename Visitor, typename... Args>
+        inline bool callVisitor(Visitor & visitor, Args &&... args)
+        {
+            if constexpr(std::is_void_v<decltype(visitor(std::forward<Args>(args)...))>)
+            {
+                visitor(std::forward<Args>(args)...);
+                return true;
+            }
+            else
+            {
+                return static_cast<bool>(visitor(std::forward<Args>(args)...));
+            }
+        }
+
+
+        /**
+         * Build the suffix array of str - its suffixes' start indices in lexicographic order, a
+         * suffix that's a prefix of another coming first - with SA-IS (Nong, Zhang & Chan), in
+         * O(str.size() + upper) time. Each symbol of str must be in [0, upper]. Used by
+         * SuffixArray, on the text's bytes, and recursively on the ranks of its LMS substrings.
+         *
+         * Classifies each suffix as S-type (smaller than the suffix after it) or L-type, sorts
+         * the LMS suffixes (S-type right after an L-type) approximately by induced sorting, names
+         * the LMS substrings by rank and recurses if any names repeat, then induces the full
+         * order from the exactly sorted LMS suffixes.
+        */
+        inline std::vector<int32_t> suffixArraySais(const std::vector<int32_t> & str, const int32_t upper)
+        {
+            const int32_t n = static_cast<int32_t>(str.size());
+            if(n < 10)
+            {
+                std::vector<int32_t> suffixes(n);
+                for(int32_t i = 0; i < n; i++)
+                {
+                    suffixes[i] = i;
+                }
+                std::sort(suffixes.begin(), suffixes.end(), [&](int32_t a, int32_t b)
+                {
+                    return std::lexicographical_compare(str.begin() + a, str.end(), str.begin() + b, str.end());
+                });
+                return suffixes;
+            }
+
+            std::vector<int32_t> suffixes(n);
+            std::vector<bool> isSType(n, false);
+            for(int32_t i = n - 2; i >= 0; i--)
+            {
+                isSType[i] = (str[i] == str[i + 1]) ? isSType[i + 1] : (str[i] < str[i + 1]);
+            }
+
+            //Where each symbol's bucket starts, for its S-type (bucketS) and L-type (bucketL) suffixes
+            std::vector<int32_t> bucketL(upper + 2, 0), bucketS(upper + 2, 0);
+            for(int32_t i = 0; i < n; i++)
+            {
+                if(!isSType[i])
+                {
+                    bucketS[str[i]]++;
+                }
+                else
+                {
+                    bucketL[str[i] + 1]++;
+                }
+            }
+            for(int32_t symbol = 0; symbol <= upper; symbol++)
+            {
+                bucketS[symbol] += bucketL[symbol];
+                if(symbol < upper)
+                {
+                    bucketL[symbol + 1] += bucketS[symbol];
+                }
+            }
+
+            auto induce = [&](const std::vector<int32_t> & lmsSuffixes)
+            {
+                std::fill(suffixes.begin(), suffixes.end(), -1);
+                std::vector<int32_t> next(bucketS.begin(), bucketS.end());
+                for(const int32_t lms : lmsSuffixes)
+                {
+                    if(lms != n)
+                    {
+                        suffixes[next[str[lms]]++] = lms;
+                    }
+                }
+                next.assign(bucketL.begin(), bucketL.end());
+                suffixes[next[str[n - 1]]++] = n - 1;
+                for(int32_t i = 0; i < n; i++)
+                {
+                    const int32_t suffix = suffixes[i];
+                    if(suffix >= 1 && !isSType[suffix - 1])
+                    {
+                        suffixes[next[str[suffix - 1]]++] = suffix - 1;
+                    }
+                }
+                next.assign(bucketL.begin(), bucketL.end());
+                for(int32_t i = n - 1; i >= 0; i--)
+                {
+                    const int32_t suffix = suffixes[i];
+                    if(suffix >= 1 && isSType[suffix - 1])
+                    {
+                        suffixes[--next[str[suffix - 1] + 1]] = suffix - 1;
+                    }
+                }
+            };
+
+            std::vector<int32_t> lmsIndex(n + 1, -1);
+            std::vector<int32_t> lmsSuffixes;
+            for(int32_t i = 1; i < n; i++)
+            {
+                if(!isSType[i - 1] && isSType[i])
+                {
+                    lmsIndex[i] = static_cast<int32_t>(lmsSuffixes.size());
+                    lmsSuffixes.push_back(i);
+                }
+            }
+            const int32_t lmsCount = static_cast<int32_t>(lmsSuffixes.size());
+
+            induce(lmsSuffixes);
+
+            if(lmsCount > 0)
+            {
+                std::vector<int32_t> sortedLms;
+                sortedLms.reserve(lmsCount);
+                for(const int32_t suffix : suffixes)
+                {
+                    if(lmsIndex[suffix] != -1)
+                    {
+                        sortedLms.push_back(suffix);
+                    }
+                }
+
+                //Name each LMS substring by its rank, equal substrings sharing a name
+                std::vector<int32_t> names(lmsCount);
+                int32_t name = 0;
+                names[lmsIndex[sortedLms[0]]] = 0;
+                for(int32_t i = 1; i < lmsCount; i++)
+                {
+                    int32_t left = sortedLms[i - 1], right = sortedLms[i];
+                    const int32_t leftEnd = (lmsIndex[left] + 1 < lmsCount) ? lmsSuffixes[lmsIndex[left] + 1] : n;
+                    const int32_t rightEnd = (lmsIndex[right] + 1 < lmsCount) ? lmsSuffixes[lmsIndex[right] + 1] : n;
+                    bool same = true;
+                    if(leftEnd - left != rightEnd - right)
+                    {
+                        same = false;
+                    }
+                    else
+                    {
+                        while(left < leftEnd && str[left] == str[right])
+                        {
+                            left++;
+                            right++;
+                        }
+                        if(left == n || right == n || str[left] != str[right])
+                        {
+                            same = false;
+                        }
+                    }
+                    if(!same)
+                    {
+                        name++;
+                    }
+                    names[lmsIndex[sortedLms[i]]] = name;
+                }
+
+                const std::vector<int32_t> namesSorted = suffixArraySais(names, name);
+                for(int32_t i = 0; i < lmsCount; i++)
+                {
+                    sortedLms[i] = lmsSuffixes[namesSorted[i]];
+                }
+                induce(sortedLms);
+            }
+            return suffixes;
+        }
+
+
+        /**
+         * A fixed sequence of bits answering rank queries (how many 1 bits come before an index)
+         * in constant time: one popcount of up to four words on top of a 32-bit running count
+         * stored every 256 bits, so the counts add 12.5% to the bits themselves.
+        */
+        class RankBitVector
+        {
+        public:
+            RankBitVector() = default;
+
+            explicit RankBitVector(const size_t length)
+                : m_words((length + 63) / 64 + 1, 0),
+                  m_blockRanks(m_words.size() / 4 + 1, 0)
+            {
+            }
+
+            void set(const size_t index)
+            {
+                m_words[index / 64] |= uint64_t(1) << (index % 64);
+            }
+
+            bool get(const size_t index) const
+            {
+                return (m_words[index / 64] >> (index % 64)) & 1;
+            }
+
+            /**
+             * Fill in the running counts - call once every bit has been set.
+            */
+            void buildRanks()
+            {
+                uint32_t count = 0;
+                for(size_t word = 0; word < m_words.size(); word++)
+                {
+                    if(word % 4 == 0)
+                    {
+                        m_blockRanks[word / 4] = count;
+                    }
+                    count += static_cast<uint32_t>(popcount64(m_words[word]));
+                }
+            }
+
+            /**
+             * @retval size_t - The number of 1 bits at indices before index.
+            */
+            size_t rank1(const size_t index) const
+            {
+                const size_t word = index / 64;
+                size_t count = m_blockRanks[word / 4];
+                for(size_t before = word & ~size_t(3); before < word; before++)
+                {
+                    count += popcount64(m_words[before]);
+                }
+                const size_t bit = index % 64;
+                if(bit != 0)
+                {
+                    count += popcount64(m_words[word] << (64 - bit));
+                }
+                return count;
+            }
+
+            size_t memoryUsage() const
+            {
+                return m_words.capacity() * sizeof(uint64_t) + m_blockRanks.capacity() * sizeof(uint32_t);
+            }
+
+        private:
+            static unsigned int popcount64(uint64_t word)
+            {
+            #if defined(_MSC_VER) && !defined(__clang__)
+                return static_cast<unsigned int>(__popcnt64(word));
+            #else
+                return static_cast<unsigned int>(__builtin_popcountll(word));
+            #endif
+            }
+
+            std::vector<uint64_t> m_words;
+            std::vector<uint32_t> m_blockRanks;
+        };
+
+
+        /**
+         * A byte sequence stored as a wavelet matrix: eight RankBitVectors, one per bit of a byte
+         * from the highest down, each level's sequence stably partitioned by that bit (0s first)
+         * before the next. Answers "how many times does byte c occur before index i" and "which
+         * byte is at index i" with eight rank queries each, in about 1.125 bytes per byte.
+        */
+        class ByteWaveletMatrix
+        {
+        public:
+            ByteWaveletMatrix() = default;
+
+            explicit ByteWaveletMatrix(std::vector<unsigned char> bytes)
+                : m_length(bytes.size())
+            {
+                std::vector<unsigned char> zeros, ones;
+                for(int level = 0; level < 8; level++)
+                {
+                    const int shift = 7 - level;
+                    m_levels[level] = RankBitVector(m_length);
+                    zeros.clear();
+                    ones.clear();
+                    for(size_t index = 0; index < m_length; index++)
+                    {
+                        if((bytes[index] >> shift) & 1)
+                        {
+                            m_levels[level].set(index);
+                            ones.push_back(bytes[index]);
+                        }
+                        else
+                        {
+                            zeros.push_back(bytes[index]);
+                        }
+                    }
+                    m_levels[level].buildRanks();
+                    m_zeroCounts[level] = zeros.size();
+                    std::copy(ones.begin(), ones.end(), std::copy(zeros.begin(), zeros.end(), bytes.begin()));
+                }
+            }
+
+            /**
+             * @retval size_t - The number of times byte occurs at indices before index.
+            */
+            size_t rank(const unsigned char byte, size_t index) const
+            {
+                size_t start = 0;
+                for(int level = 0; level < 8; level++)
+                {
+                    if((byte >> (7 - level)) & 1)
+                    {
+                        start = m_zeroCounts[level] + m_levels[level].rank1(start);
+                        index = m_zeroCounts[level] + m_levels[level].rank1(index);
+                    }
+                    else
+                    {
+                        start -= m_levels[level].rank1(start);
+                        index -= m_levels[level].rank1(index);
+                    }
+                }
+                return index - start;
+            }
+
+            /**
+             * @retval unsigned char - The byte at index.
+            */
+            unsigned char at(size_t index) const
+            {
+                unsigned char byte = 0;
+                for(int level = 0; level < 8; level++)
+                {
+                    if(m_levels[level].get(index))
+                    {
+                        byte = static_cast<unsigned char>(byte | (1u << (7 - level)));
+                        index = m_zeroCounts[level] + m_levels[level].rank1(index);
+                    }
+                    else
+                    {
+                        index -= m_levels[level].rank1(index);
+                    }
+                }
+                return byte;
+            }
+
+            size_t memoryUsage() const
+            {
+                size_t bytes = 0;
+                for(const RankBitVector & level : m_levels)
+                {
+                    bytes += level.memoryUsage();
+                }
+                return bytes;
+            }
+
+        private:
+            size_t m_length = 0;
+            RankBitVector m_levels[8];
+            size_t m_zeroCounts[8] = {};
+        };
+
+
+        /**
+         * The exact length of the string join() builds from [first, last). The elements must be
+         * convertible to std::string_view, and the range must be traversable twice - once here to
+         * size the output and once by writeJoined() to fill it.
+        */
+        template<typename Iterator>
+        inline size_t joinedLength( Iterator first,
+                                    const Iterator & last,
+                                    const size_t separatorLength,
+                                    const bool omitEmptyStrings  )
+        {
+            size_t length = 0;
+            size_t pieceCount = 0;
+            for(; first != last; ++first)
+            {
+                const size_t pieceLength = std::string_view(*first).length();
+                if(pieceLength == 0 && omitEmptyStrings)
+                {
+                    continue;
+                }
+                length += pieceLength;
+                pieceCount++;
+            }
+            return (pieceCount == 0) ? 0 : length + (pieceCount - 1) * separatorLength;
+        }
+
+
+        /**
+         * Copy the elements of [first, last), separated by separator, to out - a char * with room
+         * for joinedLength() bytes, or any other output iterator of chars.
+         *
+         * @retval Output - One past the last byte written.
+        */
+        template<typename Output, typename Iterator>
+        inline Output writeJoined(  Output out,
+                                    Iterator first,
+                                    const Iterator & last,
+                                    const std::string_view & separator,
+                                    const bool omitEmptyStrings  )
+        {
+            bool firstPiece = true;
+            for(; first != last; ++first)
+            {
+                const std::string_view piece(*first);
+                if(piece.empty() && omitEmptyStrings)
+                {
+                    continue;
+                }
+                if(!firstPiece)
+                {
+                    out = std::copy(separator.begin(), separator.end(), out);
+                }
+                out = std::copy(piece.begin(), piece.end(), out);
+                firstPiece = false;
+            }
+            return out;
+        }
+
+
+        /**
+         * View a map key or value as text for stringifyMap(): a single char as itself, anything
+         * else through its std::string_view conversion. entry must be the map's own element, as
+         * the view of a char points at it.
+        */
+        template<typename T>
+        inline std::string_view mapEntryView(const T & entry)
+        {
+            if constexpr(std::is_same_v<T, char>)
+            {
+                return std::string_view(&entry, 1);
+            }
+            else
+            {
+                return std::string_view(entry);
+            }
+        }
+
+
+        /**
+         * The exact length of the string stringifyMap() builds from map.
+        */
+        template<typename Map>
+        inline size_t stringifiedMapLength( const Map & map,
+                                            const std::string_view & keyValueSeparator,
+                                            const std::string_view & pairSeparator  )
+        {
+            size_t length = 0;
+            size_t pairCount = 0;
+            for(const auto & [key,value] : map)
+            {
+                length += mapEntryView(key).length() + mapEntryView(value).length();
+                pairCount++;
+            }
+            return (pairCount == 0) ? 0 : length + pairCount * keyValueSeparator.length() + (pairCount - 1) * pairSeparator.length();
+        }
+
+
+        /**
+         * Copy map's pairs, formatted as in stringifyMap(), to out - a char * with room for
+         * stringifiedMapLength() bytes, or any other output iterator of chars.
+         *
+         * @retval Output - One past the last byte written.
+        */
+        template<typename Output, typename Map>
+        inline Output writeStringifiedMap(  Output out,
+                                            const Map & map,
+                                            const std::string_view & keyValueSeparator,
+                                            const std::string_view & pairSeparator  )
+        {
+            bool firstPair = true;
+            for(const auto & [key,value] : map)
+            {
+                if(!firstPair)
+                {
+                    out = std::copy(pairSeparator.begin(), pairSeparator.end(), out);
+                }
+                const std::string_view keyView = mapEntryView(key), valueView = mapEntryView(value);
+                out = std::copy(keyView.begin(), keyView.end(), out);
+                out = std::copy(keyValueSeparator.begin(), keyValueSeparator.end(), out);
+                out = std::copy(valueView.begin(), valueView.end(), out);
+                firstPair = false;
+            }
+            return out;
+        }
+    }
+
+
+    /**
+     * A set of chars (bytes), compiled once into lookup tables so that testing whether a byte is a
+     * member costs the same no matter how many chars the set holds. Pass one to the functions that
+     * accept a CharSet (e.g. separate()) instead of a plain string of chars when the same set is
+     * used over and over - the string would otherwise be rescanned for every input byte.
+     *
+     * Membership is by byte, not by codepoint: a multi-byte UTF-8 character given to the
+     * constructor adds each of its bytes separately. Sets made only of ASCII chars (the common
+     * case - delimiters, digits, hex, identifier chars) additionally get a SIMD fast path.
+     *
+     * Example:
+     *
+     * CharSet delimiters(" ,;\t");
+     * std::vector<std::string> result = separate("a, b;c\td", delimiters);
+     *
+     * //Value of result is: {"a","b","c","d"}
+    */
+    class CharSet
+    {
+    public:
+        CharSet() = default;
+
+        /**
+         * @param chars - Every char in this string becomes a member of the set.
+        */
+        explicit CharSet(const std::string_view & chars)
+        {
+            for(const char ch : chars)
+            {
+                m_tables.add(static_cast<unsigned char>(ch));
+            }
+        }
+
+        /**
+         * @retval bool - True if ch is a member of this set.
+        */
+        bool contains(const char ch) const
+        {
+            return m_tables.test(static_cast<unsigned char>(ch));
+        }
+
+        /**
+         * @retval bool - True if this set has no members.
+        */
+        bool empty() const
+        {
+            return (m_tables.bitmap[0] | m_tables.bitmap[1] | m_tables.bitmap[2] | m_tables.bitmap[3]) == 0;
+        }
+
+        /**
+         * The compiled lookup tables, for the scanning kernels in the detail namespace.
+        */
+        const detail::CharSetTables & tables() const
+        {
+            return m_tables;
+        }
+
+    private:
+        detail::CharSetTables m_tables;
+    };
+
+
+    /**
+     * Settings for the parallel variants of this library's functions (e.g. separate()), which split
+     * their input into chunks and work on each chunk on its own thread.
+     *
+     *   threadCount  (default 0)       — the most threads to use; 0 means one per hardware thread
+     *   minChunkSize (default 1 MiB)   — the fewest input bytes worth giving a thread; inputs
+     *                                    shorter than two chunks just run serially
+    */
+    struct ParallelSettings
+    {
+        unsigned int threadCount  = 0;
+        size_t       minChunkSize = size_t(1) << 20;
+    };
+
+
+    /**
+     * A substring to search for, preprocessed once so it can be searched for many times - pass it
+     * to separate(), findAll(), contains() or replaceSubstr() in place of the plain substring when
+     * the same needle is used over and over (e.g. splitting millions of records on " and ").
+     *
+     * On x86-64 a search filters 16 or 32 candidate positions at a time by comparing the needle's
+     * first and last chars with SIMD (AVX2 when the running CPU has it), and only fully compares
+     * the candidates that pass. Elsewhere it falls back to Boyer-Moore-Horspool, whose shift table
+     * is what gets precomputed.
+     *
+     * Example:
+     *
+     * const Searcher andSearcher(" and ");
+     * for(const std::string & record : records)
+     * {
+     *     std::vector<std::string> names = separate(record, andSearcher);
+     * }
+    */
+    class Searcher
+    {
+    public:
+        /**
+         * @param needle - The substring to search for. It's copied, so it needn't outlive the Searcher.
+        */
+        explicit Searcher(const std::string_view & needle)
+            : m_needle(needle)
+        {
+        #if !defined(STEVENSSTRINGLIB_X86_SIMD)
+            //Horspool: how far the search window can shift when its last char is a given char
+            std::fill(std::begin(m_shift), std::end(m_shift), std::max<size_t>(m_needle.length(), 1));
+            for(size_t i = 0; i + 1 < m_needle.length(); i++)
+            {
+                m_shift[static_cast<unsigned char>(m_needle[i])] = m_needle.length() - 1 - i;
+            }
+        #endif
+        }
+
+        /**
+         * @retval const std::string & - The substring this Searcher searches for.
+        */
+        const std::string & needle() const
+        {
+            return m_needle;
+        }
+
+        /**
+         * @retval size_t - The length of the needle in bytes.
+        */
+        size_t length() const
+        {
+            return m_needle.length();
+        }
+
+        /**
+         * Find the first occurrence of the needle in haystack at or after from. Same result as
+         * haystack.find(needle(), from), including for an empty needle.
+         *
+         * @param haystack - The string to search.
+         * @param from - The index to start searching at.
+         *
+         * @retval size_t - The index of the occurrence, or std::string_view::npos if there is none.
+        */
+        size_t find(const std::string_view & haystack, size_t from = 0) const
+        {
+            const size_t needleLength = m_needle.length();
+            if(from > haystack.length() || haystack.length() - from < needleLength)
+            {
+                return std::string_view::npos;
+            }
+            if(needleLength <= 1)
+            {
+                return (needleLength == 0) ? from : haystack.find(m_needle[0], from);
+            }
+        #if defined(STEVENSSTRINGLIB_AVX2_DISPATCH)
+            if(detail::cpuSupportsAvx2())
+            {
+                return detail::findSubstringAvx2(haystack, from, m_needle);
+            }
+        #endif
+        #if defined(STEVENSSTRINGLIB_X86_SIMD)
+            return detail::findSubstringSse2(haystack, from, m_needle);
+        #else
+            return findHorspool(haystack, from);
+        #endif
+        }
+
+    private:
+    #if !defined(STEVENSSTRINGLIB_X86_SIMD)
+        size_t findHorspool(const std::string_view & haystack, size_t from) const
+        {
+            const size_t lastOffset = m_needle.length() - 1;
+            while(from + lastOffset < haystack.length())
+            {
+                const char windowLast = haystack[from + lastOffset];
+                if(windowLast == m_needle[lastOffset]
+                   && std::memcmp(haystack.data() + from, m_needle.data(), lastOffset) == 0)
+                {
+                    return from;
+                }
+                from += m_shift[static_cast<unsigned char>(windowLast)];
+            }
+            return std::string_view::npos;
+        }
+    #endif
+
+        std::string m_needle;
+    #if !defined(STEVENSSTRINGLIB_X86_SIMD)
+        size_t m_shift[256];
+    #endif
+    };
+
+
+    /**
+     * One hit reported by a MultiPatternMatcher: which pattern matched (its index in the vector
+     * the matcher was built from), and the index in the searched string the match starts at.
+    */
+    struct PatternMatch
+    {
+        size_t patternId;
+        size_t offset;
+    };
+
+
+    /**
+     * A set of patterns compiled into an Aho-Corasick automaton, for finding every occurrence of
+     * every pattern in one pass over a string - instead of one findAll() pass per pattern. Pass it
+     * to findAll() or forEachOccurrence() in place of a single substring.
+     *
+     * The automaton is stored as a dense transition table over byte classes: bytes that appear
+     * in no pattern all share one class, so a row only has as many entries as there are distinct
+     * pattern bytes, and each step of the scan is a single table lookup. With caseInsensitive,
+     * ASCII letters match regardless of case. Empty patterns never match.
+     *
+     * Example:
+     *
+     * MultiPatternMatcher keywords({"error", "timeout", "out"});
+     * std::vector<PatternMatch> hits = findAll("timeout error", keywords);
+     * //hits == {{1, 0}, {2, 4}, {0, 8}} - "timeout" at 0, "out" at 4, "error" at 8
+    */
+    class MultiPatternMatcher
+    {
+    public:
+        /**
+         * @param patterns - The patterns to look for. A pattern's id is its index in this vector.
+         * @param caseInsensitive - If true, ASCII letters match regardless of case.
+        */
+        explicit MultiPatternMatcher(   const std::vector<std::string> & patterns,
+                                        const bool caseInsensitive = false  )
+            : m_patternLengths(patterns.size())
+        {
+            //Give every distinct byte of the patterns its own class, folding case if asked
+            std::fill(std::begin(m_byteClass), std::end(m_byteClass), static_cast<uint16_t>(0));
+            m_classCount = 1;
+            for(const std::string & pattern : patterns)
+            {
+                for(const char ch : pattern)
+                {
+                    const unsigned char byte = foldCase(static_cast<unsigned char>(ch), caseInsensitive);
+                    if(m_byteClass[byte] == 0)
+                    {
+                        m_byteClass[byte] = static_cast<uint16_t>(m_classCount++);
+                    }
+                }
+            }
+            if(caseInsensitive)
+            {
+                for(unsigned int byte = 'A'; byte <= 'Z'; byte++)
+                {
+                    m_byteClass[byte] = m_byteClass[byte - 'A' + 'a'];
+                }
+            }
+
+            //Build the trie - missing edges are marked and filled in below
+            const uint32_t noEdge = std::numeric_limits<uint32_t>::max();
+            std::vector<std::vector<uint32_t>> outputs(1);
+            m_transitions.assign(m_classCount, noEdge);
+            for(size_t patternId = 0; patternId < patterns.size(); patternId++)
+            {
+                const std::string & pattern = patterns[patternId];
+                m_patternLengths[patternId] = pattern.length();
+                if(pattern.empty())
+                {
+                    continue;
+                }
+                uint32_t state = 0;
+                for(const char ch : pattern)
+                {
+                    const size_t edge = state * m_classCount + classOf(ch);
+                    if(m_transitions[edge] == noEdge)
+                    {
+                        m_transitions[edge] = static_cast<uint32_t>(outputs.size());
+                        outputs.emplace_back();
+                        m_transitions.resize(m_transitions.size() + m_classCount, noEdge);
+                    }
+                    state = m_transitions[edge];
+                }
+                outputs[state].push_back(static_cast<uint32_t>(patternId));
+            }
+
+            //Breadth-first, turn the trie into a full automaton: each missing edge goes where the
+            //state's failure link (longest proper suffix that's also a trie state) goes, and each
+            //state also reports everything its failure link reports
+            const size_t stateCount = outputs.size();
+            std::vector<uint32_t> failure(stateCount, 0);
+            std::vector<uint32_t> queue;
+            queue.reserve(stateCount);
+            for(size_t byteClass = 0; byteClass < m_classCount; byteClass++)
+            {
+                uint32_t & child = m_transitions[byteClass];
+                if(child == noEdge)
+                {
+                    child = 0;
+                }
+                else
+                {
+                    queue.push_back(child);
+                }
+            }
+            for(size_t next = 0; next < queue.size(); next++)
+            {
+                const uint32_t state = queue[next];
+                const std::vector<uint32_t> & inherited = outputs[failure[state]];
+                outputs[state].insert(outputs[state].end(), inherited.begin(), inherited.end());
+                for(size_t byteClass = 0; byteClass < m_classCount; byteClass++)
+                {
+                    uint32_t & child = m_transitions[state * m_classCount + byteClass];
+                    const uint32_t failureChild = m_transitions[failure[state] * m_classCount + byteClass];
+                    if(child == noEdge)
+                    {
+                        child = failureChild;
+                    }
+                    else
+                    {
+                        failure[child] = failureChild;
+                        queue.push_back(child);
+                    }
+                }
+            }
+
+            //Flatten the per-state outputs so the scan reads one contiguous array
+            m_outputStart.resize(stateCount + 1, 0);
+            for(size_t state = 0; state < stateCount; state++)
+            {
+                m_outputStart[state + 1] = m_outputStart[state] + static_cast<uint32_t>(outputs[state].size());
+                m_outputs.insert(m_outputs.end(), outputs[state].begin(), outputs[state].end());
+            }
+        }
+
+        /**
+         * @retval size_t - The number of patterns this matcher was built from.
+        */
+        size_t patternCount() const
+        {
+            return m_patternLengths.size();
+        }
+
+        /**
+         * @param patternId - The index of a pattern in the vector this matcher was built from.
+         *
+         * @retval size_t - The length of that pattern in bytes.
+        */
+        size_t patternLength(const size_t patternId) const
+        {
+            return m_patternLengths[patternId];
+        }
+
+        /**
+         * Call visitor(match) for every occurrence of every pattern in str, with match a
+         * PatternMatch, in the order the occurrences end in str (occurrences ending at the same
+         * index come longest pattern first). If visitor returns bool, returning false stops the
+         * scan early.
+         *
+         * @param str - The string to search.
+         * @param visitor - Callable taking a PatternMatch, returning void or bool (false to stop).
+         *
+         * @retval bool - False if visitor stopped the scan early, true otherwise.
+        */
+        template<typename Visitor>
+        bool forEachMatch(const std::string_view & str, Visitor && visitor) const
+        {
+            const uint32_t * const transitions = m_transitions.data();
+            uint32_t state = 0;
+            for(size_t index = 0; index < str.length(); index++)
+            {
+                state = transitions[state * m_classCount + classOf(str[index])];
+                for(uint32_t output = m_outputStart[state]; output < m_outputStart[state + 1]; output++)
+                {
+                    const uint32_t patternId = m_outputs[output];
+                    if(!detail::callVisitor(visitor, PatternMatch{patternId, index + 1 - m_patternLengths[patternId]}))
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+    private:
+        static unsigned char foldCase(unsigned char byte, bool caseInsensitive)
+        {
+            if(caseInsensitive && byte >= 'A' && byte <= 'Z')
+            {
+                return static_cast<unsigned char>(byte - 'A' + 'a');
+            }
+            return byte;
+        }
+
+        size_t classOf(char ch) const
+        {
+            return m_byteClass[static_cast<unsigned char>(ch)];
+        }
+
+        uint16_t m_byteClass[256];
+        size_t m_classCount;
+        std::vector<uint32_t> m_transitions; // m_classCount entries per state, state 0 is the root
+        std::vector<uint32_t> m_outputStart; // m_outputs[m_outputStart[s], m_outputStart[s + 1]) are state s's patterns
+        std::vector<uint32_t> m_outputs;
+        std::vector<size_t> m_patternLengths;
+    };
+
+
+    /**
+     * @deprecated
+     * In C++23 and onward, please use the std::string::contains() method instead of this function.
+     * 
+     * Given a string, determine whether it has an occurrence of the substring somewhere 
+     * within it.
+     * 
+     *  @param str - The std::string we are examining to see if it contains the substring.
+     *  @param substring - The substring we are checking to if it is contained in str.
+     * 
+     *  @retval bool - indicates that input std::string contains the substring (true) or not (false).
+     */
+    inline bool contains(   const std::string_view & str,
+                            const std::string_view & substring   )
+    {
+        return (str.find(substring) != std::string::npos);
+    }
+
+
+    /**
+     * @deprecated
+     * In C++23 and onward, please use the std::string::contains() method instead of this function.
+     * 
+     * Given a string, determine whether it has an occurrence of a character somewhere 
+     * within it.
+     * 
+     *  @param str - The std::string we are examining to see if it contains the substring.
+     *  @param ch - The char we are checking to see if it is contained in str.
+     * 
+     *  @retval bool -  indicates that input std::string contains the substring (true) or not (false).
+     */
+    inline bool contains(   const std::string_view & str,
+                            const char ch  )
+    {
+        return (str.find(ch) != std::string::npos);
+    }
+
+
+    /**
+     * Variant of contains that looks for a precompiled Searcher's needle.
+     *
+     *  @param str - The std::string we are examining to see if it contains the substring.
+     *  @param searcher - The Searcher for the substring we are checking to see if it is contained in str.
+     *
+     *  @retval bool - indicates that input std::string contains the substring (true) or not (false).
+     */
+    inline bool contains(   const std::string_view & str,
+                            const Searcher & searcher  )
+    {
+        return (searcher.find(str) != std::string::npos);
+    }
+
+
+    /**
+     * Variant of contains that checks whether str has any character that's a member of a CharSet.
+     *
+     *  @param str - The std::string we are examining to see if it contains any of the characters.
+     *  @param set - The compiled set of characters we are looking for in str.
+     *
+     *  @retval bool - indicates that input std::string contains a member of set (true) or not (false).
+     */
+    inline bool contains(   const std::string_view & str,
+                            const CharSet & set  )
+    {
+        return (detail::findCharSetPosition(str, 0, set.tables(), true) != std::string::npos);
+    }
+
+
+    /**
+     * Variant of contains that checks whether str contains any of the patterns of a
+     * MultiPatternMatcher, in one pass over str that stops at the first hit.
+     *
+     *  @param str - The std::string we are examining to see if it contains any of the patterns.
+     *  @param needles - The compiled patterns we are checking to see if any is contained in str.
+     *
+     *  @retval bool - indicates that input std::string contains at least one pattern (true) or not (false).
+     */
+    inline bool contains(   const std::string_view & str,
+                            const MultiPatternMatcher & needles  )
+    {
+        for(size_t patternId = 0; patternId < needles.patternCount(); patternId++)
+        {
+            if(needles.patternLength(patternId) == 0)
+            {
+                return true;
+            }
+        }
+        return !needles.forEachMatch(str, [](const PatternMatch &)
+        {
+            return false;
+        });
+    }
+
+
+    /**
+     * Batch variant of contains for checking one haystack against many needles at once, e.g. a row
+     * of a table against every keyword of a filter. Rather than one contains() call (and one scan
+     * of str) per needle, the needles are compiled once into a MultiPatternMatcher, and str is
+     * scanned once for all of them - stopping as soon as every needle has been seen.
+     *
+     * Example:
+     *
+     * const MultiPatternMatcher keywords({"error", "timeout", "disk"});
+     * std::vector<bool> found = containsWhich("timeout while writing", keywords);
+     *
+     * //Value of found is: {false, true, false}
+     *
+     * @param str - The std::string we are examining to see which needles it contains.
+     * @param needles - The compiled needles we are checking for in str.
+     *
+     * @retval std::vector<bool> - Element i is true if needle i (by its index in the vector the
+     *         MultiPatternMatcher was built from) is contained in str. Empty needles are always contained.
+     */
+    inline std::vector<bool> containsWhich( const std::string_view & str,
+                                            const MultiPatternMatcher & needles  )
+    {
+        std::vector<bool> found(needles.patternCount(), false);
+        size_t foundCount = 0;
+        for(size_t patternId = 0; patternId < needles.patternCount(); patternId++)
+        {
+            if(needles.patternLength(patternId) == 0)
+            {
+                found[patternId] = true;
+                foundCount++;
+            }
+        }
+        if(foundCount < found.size())
+        {
+            needles.forEachMatch(str, [&](const PatternMatch & match)
+            {
+                if(!found[match.patternId])
+                {
+                    found[match.patternId] = true;
+                    foundCount++;
+                }
+                return foundCount < found.size();
+            });
+        }
+        return found;
+    }
+
+
+    /**
+     * Batch variant of contains for checking many haystacks against one needle at once, e.g. every
+     * row of a table against one filter term. The needle is preprocessed once, as a Searcher, and
+     * each haystack is scanned with it in turn.
+     *
+     * Example:
+     *
+     * std::vector<std::string> rows = {"disk full", "ok", "disk slow"};
+     * std::vector<size_t> matching = whichContain(rows, Searcher("disk"));
+     *
+     * //Value of matching is: {0, 2}
+     *
+     * @param haystacks - Any range (e.g. a std::vector) of std::strings, std::string_views or
+     *                    other types convertible to std::string_view.
+     * @param needle - The Searcher for the substring we are looking for in each haystack.
+     *
+     * @retval std::vector<size_t> - The indices, in increasing order, of the haystacks that contain the needle.
+     */
+    template<typename Haystacks>
+    inline std::vector<size_t> whichContain(    const Haystacks & haystacks,
+                                                const Searcher & needle  )
+    {
+        std::vector<size_t> indices;
+        size_t index = 0;
+        for(const auto & haystack : haystacks)
+        {
+            if(needle.find(std::string_view(haystack)) != std::string_view::npos)
+            {
+                indices.push_back(index);
+            }
+            index++;
+        }
+        return indices;
+    }
+
+
+    /**
+     * Variant of whichContain that takes the needle as a plain substring, and builds the Searcher
+     * for it once for the whole batch.
+     *
+     * @param haystacks - Any range (e.g. a std::vector) of std::strings, std::string_views or
+     *                    other types convertible to std::string_view.
+     * @param needle - The substring we are looking for in each haystack.
+     *
+     * @retval std::vector<size_t> - The indices, in increasing order, of the haystacks that contain the needle.
+     */
+    template<typename Haystacks>
+    inline std::vector<size_t> whichContain(    const Haystacks & haystacks,
+                                                const std::string_view & needle  )
+    {
+        return whichContain(haystacks, Searcher(needle));
+    }
+
+
+    /**
+     * Variant of whichContain for checking many haystacks against many needles, e.g. every row of
+     * a table against a filter's keywords: finds the haystacks that contain at least one of the
+     * needles, scanning each haystack once and only until its first hit.
+     *
+     * @param haystacks - Any range (e.g. a std::vector) of std::strings, std::string_views or
+     *                    other types convertible to std::string_view.
+     * @param needles - The compiled needles we are looking for in each haystack.
+     *
+     * @retval std::vector<size_t> - The indices, in increasing order, of the haystacks that contain any needle.
+     */
+    template<typename Haystacks>
+    inline std::vector<size_t> whichContain(    const Haystacks & haystacks,
+                                                const MultiPatternMatcher & needles  )
+    {
+        std::vector<size_t> indices;
+        size_t index = 0;
+        for(const auto & haystack : haystacks)
+        {
+            if(contains(std::string_view(haystack), needles))
+            {
+                indices.push_back(index);
+            }
+            index++;
+        }
+        return indices;
+    }
+
+
+    /**
+     * @brief Given a string, determine if it contains only the characters in the given string.
+     * 
+     * Example:
+     * containsOnly("11101112222","12")
+     * 
+     * Result: false, str contains the character '0', which is not equal to '1', or '2';
+     * 
+     * @param str - The std::string we are checking to see if it only contains characters present in the chars string.
+     * @param chars - A std::string of characters we are checking to see if str contains any characters that are not in chars.
+     * @retval bool - true if str contains only instances of keys in substrs. False if str contains at least one substring that is not present as a key in substrs.
+     */
+    inline bool containsOnly(   const std::string_view & str,
+                                const std::string_view & chars )
+    {
+        //If chars is empty, we are limiting a std::string that returns as true to also be empty.
+        if(chars.empty())
+        {
+            if(str.empty())
+            {
+                //The std::string contains nothing and it can only contain no characters, therefore return true
+                return true;
+            }
+            else
+            {
+                //The std::string contains something while it can only contain no characters, therefore return false
+                return false;
+            }
+        }
+
+        return str.find_first_not_of(chars) == std::string::npos;
+    }
+
+
+    /**
+     * Variant of containsOnly that checks str against a precompiled CharSet, for validating many
+     * strings against the same set (e.g. identifiers, hex strings). find_first_not_of() scans the
+     * allowed chars again for every byte of str; a CharSet tests each byte with one table lookup,
+     * and 32 bytes at a time with SIMD when the CPU and the set allow it.
+     *
+     * Example:
+     *
+     * const CharSet hexDigits("0123456789abcdefABCDEF");
+     * containsOnly("deadBEEF", hexDigits); //true
+     * containsOnly("0x1f", hexDigits);     //false, 'x' is not a hex digit
+     *
+     * @param str - The std::string we are checking to see if it only contains members of set.
+     * @param set - The compiled set of characters str may contain.
+     * @retval bool - true if every character of str is a member of set (so also if str is empty). False otherwise.
+     */
+    inline bool containsOnly(   const std::string_view & str,
+                                const CharSet & set )
+    {
+        return detail::findCharSetPosition(str, 0, set.tables(), false) == std::string::npos;
+    }
+
+
+    /**
+     * Find the first character of str at or after index from that's a member of a CharSet. Same
+     * result as str.find_first_of(chars, from) for the chars the set was built from.
+     *
+     * @param str - The std::string we are searching.
+     * @param set - The compiled set of characters we are looking for.
+     * @param from - The index to start searching at.
+     *
+     * @retval size_t - The index of the first member of set, or std::string::npos if there is none.
+     */
+    inline size_t findFirstOf(  const std::string_view & str,
+                                const CharSet & set,
+                                const size_t from = 0  )
+    {
+        return detail::findCharSetPosition(str, from, set.tables(), true);
+    }
+
+
+    /**
+     * Find the first character of str at or after index from that's not a member of a CharSet.
+     * Same result as str.find_first_not_of(chars, from) for the chars the set was built from.
+     *
+     * @param str - The std::string we are searching.
+     * @param set - The compiled set of characters we are skipping over.
+     * @param from - The index to start searching at.
+     *
+     * @retval size_t - The index of the first non-member of set, or std::string::npos if there is none.
+     */
+    inline size_t findFirstNotOf(   const std::string_view & str,
+                                    const CharSet & set,
+                                    const size_t from = 0  )
+    {
+        return detail::findCharSetPosition(str, from, set.tables(), false);
+    }
+
+
+    /**
+     * Find the last character of str at or before index pos that's a member of a CharSet. Same
+     * result as str.find_last_of(chars, pos) for the chars the set was built from.
+     *
+     * @param str - The std::string we are searching.
+     * @param set - The compiled set of characters we are looking for.
+     * @param pos - The index to start searching backwards from. By default, the end of str.
+     *
+     * @retval size_t - The index of the last member of set, or std::string::npos if there is none.
+     */
+    inline size_t findLastOf(   const std::string_view & str,
+                                const CharSet & set,
+                                const size_t pos = std::string::npos  )
+    {
+        return detail::findLastCharSetPosition(str, (pos == std::string::npos) ? pos : pos + 1, set.tables(), true);
+    }
+
+
+    /**
+     * Find the last character of str at or before index pos that's not a member of a CharSet.
+     * Same result as str.find_last_not_of(chars, pos) for the chars the set was built from.
+     *
+     * @param str - The std::string we are searching.
+     * @param set - The compiled set of characters we are skipping over.
+     * @param pos - The index to start searching backwards from. By default, the end of str.
+     *
+     * @retval size_t - The index of the last non-member of set, or std::string::npos if there is none.
+     */
+    inline size_t findLastNotOf(    const std::string_view & str,
+                                    const CharSet & set,
+                                    const size_t pos = std::string::npos  )
+    {
+        return detail::findLastCharSetPosition(str, (pos == std::string::npos) ? pos : pos + 1, set.tables(), false);
+    }
+
+
+     /**
+     * Given a std::string str, erase the last n characters of the string.
+     * 
+     * Credit to Varun: https://thispointer.com/remove-last-n-characters-from-a-string-in-c/
+     * 
+     * @param str - The std::string we want to erase characters from the end of.
+     * @param n - The number of characters we want to erase
+     * 
+     * @retval std::string - The string str having n characters erased from the end of it.
+    */
+    inline std::string eraseCharsFromEnd(   std::string str,
+                                            size_t n   )
+    {
+        //Can't erase from empty strings, and we can't erase more characters from the std::string than what we have
+        if(str.size() <= n)
+        {
+            return "";
+        }
+
+        str.erase(str.size() - n);
+        return str;
+    }
+
+
+    /**
+     * @brief Given a std::string str, erase the first n characters of the string.
+     * 
+     * Credit to Michael Krelin: https://stackoverflow.com/a/12692267/16511184
+     * 
+     * @param str - The std::string we want to erase characters from the start of.
+     * @param n - The number of characters we want to erase
+     * 
+     */
+    inline std::string eraseCharsFromStart( std::string str,
+                                            size_t n    )
+    {
+        //Can't erase from empty strings, and we can't erase more characters from the std::string than what we have
+        if(str.size() <= n)
+        {
+            return "";
+        }
+
+        str.erase(0, n);
+        return str;
+    }
+
+
+    /**
+     * @deprecated
+     * In C++20 and onward, please use std::string.starts_with instead.
+     * 
+     * @brief Check a std::string to see if it begins with a substring.
+     * 
+     * @param str - The std::string we are checking to see if it begins with another substring.
+     * @param substr - The substring we are checking the beginning of str against to see if they are equal.
+     * 
+     * @retval bool - True if the std::string str begins with substr. False if the std::string str does NOT begin with substr.
+     */
+    inline bool startsWith(     const std::string_view & str, 
+                                const std::string_view & substr )
+    {
+        //If the substring is longer than the string, then it's not possible for the std::string to start with the substring
+        if(str.length() < substr.length())
+        {
+            return false;
+        }
+        //Check the beginning of str to see if it is equivalent to substr
+        if(str.substr(0,substr.length()) == substr)
+        {
+            return true;
+        }
+        return false;
+    }
+
+
+    /**
+     * @brief Check a std::string to see if it ends with a substring.
+     * 
+     * @param str - The std::string we are checking the end of to see if it ends with substr.
+     * @param substr - The substr we are checking to see if str ends with.
+     * 
+     * @retval bool - True if the std::string str ends with substr. False if the str does not end with with substr.
+     */
+    inline bool endsWith(   const std::string_view & str,
+                            const std::string_view & substr    )
+    {
+        //If the substring is longer than the string, then it's not possible for the std::string to start with the substring
+        if (str.size() < substr.size())
+        {
+            return false;
+        }
+        return std::equal(substr.rbegin(), substr.rend(), str.rbegin());
+    }
+
+
+    /**
+     * Variant of contains that ignores case, without the toLower() copies of both strings that
+     * contains(toLower(str), toLower(substring)) would make.
+     *
+     * When both strings are plain ASCII, letters are folded on the fly 16 bytes at a time with
+     * SIMD. Otherwise they're compared codepoint by codepoint under Unicode's simple lowercase
+     * mapping (e.g. "Ä" matches "ä"), which throws utf8::invalid_utf8 on malformed UTF-8. One
+     * codepoint never matches several, so "ß" does not match "SS".
+     *
+     * Example:
+     *
+     * containsIgnoreCase("Content-Type: text/HTML", "text/html"); //true
+     *
+     *  @param str - The std::string we are examining to see if it contains the substring.
+     *  @param substring - The substring we are checking to if it is contained in str, in any case.
+     *
+     *  @retval bool - indicates that input std::string contains the substring ignoring case (true) or not (false).
+     */
+    inline bool containsIgnoreCase( const std::string_view & str,
+                                    const std::string_view & substring   )
+    {
+        if(detail::isAscii(substring) && detail::isAscii(str))
+        {
+            return detail::findAsciiIgnoreCase(str, 0, substring) != std::string_view::npos;
+        }
+        return detail::findFoldedCodepoints(str, 0, substring) != std::string_view::npos;
+    }
+
+
+    /**
+     * Variant of startsWith that ignores case, folding on the fly rather than copying either
+     * string - see containsIgnoreCase() for how case is compared.
+     *
+     * @param str - The std::string we are checking to see if it begins with another substring.
+     * @param substr - The substring we are checking the beginning of str against, in any case.
+     *
+     * @retval bool - True if the std::string str begins with substr ignoring case. False otherwise.
+     */
+    inline bool startsWithIgnoreCase(   const std::string_view & str,
+                                        const std::string_view & substr )
+    {
+        if(detail::isAscii(substr))
+        {
+            //Each char of an ASCII substr needs at least one byte of str, and if that stretch of str
+            //is ASCII too, it can be compared byte for byte
+            if(str.length() < substr.length())
+            {
+                return false;
+            }
+            if(detail::isAscii(str.substr(0, substr.length())))
+            {
+                return detail::equalsAsciiIgnoreCase(str.data(), substr.data(), substr.length());
+            }
+        }
+        return detail::matchFoldedCodepoints(str, 0, substr) != std::string_view::npos;
+    }
+
+
+    /**
+     * Variant of endsWith that ignores case, folding on the fly rather than copying either
+     * string - see containsIgnoreCase() for how case is compared.
+     *
+     * @param str - The std::string we are checking the end of to see if it ends with substr.
+     * @param substr - The substr we are checking to see if str ends with, in any case.
+     *
+     * @retval bool - True if the std::string str ends with substr ignoring case. False otherwise.
+     */
+    inline bool endsWithIgnoreCase( const std::string_view & str,
+                                    const std::string_view & substr    )
+    {
+        if(detail::isAscii(substr))
+        {
+            if(str.length() < substr.length())
+            {
+                return false;
+            }
+            const size_t start = str.length() - substr.length();
+            if(detail::isAscii(str.substr(start)))
+            {
+                return detail::equalsAsciiIgnoreCase(str.data() + start, substr.data(), substr.length());
+            }
+        }
+        //Lowercasing maps one codepoint to one codepoint, so a match starts as many codepoints from
+        //the end of str as substr has
+        size_t codepointCount = 0;
+        for(const char ch : substr)
+        {
+            codepointCount += ((static_cast<unsigned char>(ch) & 0xC0) != 0x80);
+        }
+        size_t start = str.length();
+        while(codepointCount > 0)
+        {
+            if(start == 0)
+            {
+                return false;
+            }
+            start--;
+            if((static_cast<unsigned char>(str[start]) & 0xC0) != 0x80)
+            {
+                codepointCount--;
+            }
+        }
+        return detail::matchFoldedCodepoints(str, start, substr) == str.length();
+    }
+
+
+    /**
+     * Variant of findAll that ignores case, folding on the fly rather than searching toLower()
+     * copies of both strings - see containsIgnoreCase() for how case is compared. Like findAll,
+     * occurrences may overlap. Indices are byte indices into str; outside plain ASCII, only
+     * codepoint boundaries are candidates (so an empty substr is found at every boundary).
+     *
+     * @param str - The std::string we are searching for the substring in.
+     * @param substr - The substring we are looking for within std::string str, in any case.
+     *
+     * @retval std::vector<size_t> - A vector containing all indices in increasing order that the substr occurs at.
+    */
+    inline std::vector<size_t> findAllIgnoreCase(   const std::string_view & str,
+                                                    const std::string_view & substr  )
+    {
+        std::vector<size_t> positions;
+        const bool ascii = detail::isAscii(substr) && detail::isAscii(str);
+        auto findFrom = [&](size_t from)
+        {
+            return ascii ? detail::findAsciiIgnoreCase(str, from, substr) : detail::findFoldedCodepoints(str, from, substr);
+        };
+
+        size_t pos = findFrom(0);
+        while(pos != std::string::npos)
+        {
+            positions.push_back(pos);
+            if(pos == str.length())
+            {
+                break;
+            }
+            //Resume at the next char, or the next codepoint boundary outside ASCII
+            size_t next = pos + 1;
+            while(!ascii && next < str.length() && (static_cast<unsigned char>(str[next]) & 0xC0) == 0x80)
+            {
+                next++;
+            }
+            pos = findFrom(next);
+        }
+
+        return positions;
+    }
+
+
+    /**
+     * Given a std::string str, find all occurrences of a substring within it. Returns a vector of all of the indices that the substring
+     * occurs at within the std::string str.
+     * 
+     * Credit to Benjamin Lindley: https://stackoverflow.com/a/4034809
+     * 
+     * @param str - The std::string we are searching for the substring in.
+     * @param substr - The substring we are looking for within std::string str.
+     * 
+     * @retval std::vector<size_t> - A vector containing all indices in increasing order that the substr occurs at.
+    */
+    inline std::vector<size_t> findAll(     const std::string & str,
+                                            const std::string & substr  )
+    {
+        std::vector<size_t> positions;
+
+        size_t pos = str.find(substr, 0);
+        while(pos != std::string::npos)
+        {
+            positions.push_back(pos);
+            pos = str.find(substr,pos+1);
+        }
+
+        return positions;
+    }
+
+
+    /**
+     * Given a std::string str, find all occurrences of a character within it. Returns a vector of all of the indices that the character
+     * occurs at within the std::string str.
+     * 
+     * Credit to Benjamin Lindley: https://stackoverflow.com/a/4034809
+     * 
+     * @param str - The std::string we are searching for the substring in.
+     * @param ch - The character we are looking for within std::string str.
+     * 
+     * @retval std::vector<size_t> - A vector containing all indices in increasing order that ch occurs at.
+    */
+    inline std::vector<size_t> findAll(     const std::string & str,
+                                            const char ch  )
+    {
+        //Count first so positions is allocated exactly once, then collect them with the same SIMD scan
+        std::vector<size_t> positions;
+        positions.reserve(detail::countChar(str, ch));
+        detail::forEachCharPosition(str, ch, [&](size_t pos)
+        {
+            positions.push_back(pos);
+            return true;
+        });
+
+        return positions;
+    }
+
+
+    /**
+     * Variant of findAll that finds all occurrences of a precompiled Searcher's needle. Like the
+     * substring variant, occurrences may overlap.
+     *
+     * @param str - The std::string we are searching for the substring in.
+     * @param searcher - The Searcher for the substring we are looking for within std::string str.
+     *
+     * @retval std::vector<size_t> - A vector containing all indices in increasing order that the substring occurs at.
+    */
+    inline std::vector<size_t> findAll(     const std::string_view & str,
+                                            const Searcher & searcher  )
+    {
+        std::vector<size_t> positions;
+
+        size_t pos = searcher.find(str, 0);
+        while(pos != std::string::npos)
+        {
+            positions.push_back(pos);
+            pos = searcher.find(str, pos+1);
+        }
+
+        return positions;
+    }
+
+
+    /**
+     * Variant of findAll that lets you choose whether occurrences may overlap. With overlapping
+     * true this is the same as findAll(str, substr). With overlapping false, searching resumes
+     * after the end of each occurrence rather than one char past its start - so "aa" occurs at
+     * {0, 2} in "aaaaa", rather than {0, 1, 2, 3}. These are the occurrences separate() and
+     * replaceSubstr() act on.
+     *
+     * @param str - The std::string we are searching for the substring in.
+     * @param substr - The substring we are looking for within std::string str.
+     * @param overlapping - If true, report occurrences that overlap an earlier one too.
+     *
+     * @retval std::vector<size_t> - A vector containing all indices in increasing order that the substr occurs at.
+    */
+    inline std::vector<size_t> findAll(     const std::string & str,
+                                            const std::string & substr,
+                                            const bool overlapping  )
+    {
+        std::vector<size_t> positions;
+        const size_t step = overlapping ? 1 : std::max<size_t>(substr.length(), 1);
+
+        size_t pos = str.find(substr, 0);
+        while(pos != std::string::npos)
+        {
+            positions.push_back(pos);
+            pos = str.find(substr, pos+step);
+        }
+
+        return positions;
+    }
+
+
+    /**
+     * Variant of findAll that finds occurrences of a precompiled Searcher's needle, and lets you
+     * choose whether they may overlap - see the substring variant.
+     *
+     * @param str - The std::string we are searching for the substring in.
+     * @param searcher - The Searcher for the substring we are looking for within std::string str.
+     * @param overlapping - If true, report occurrences that overlap an earlier one too.
+     *
+     * @retval std::vector<size_t> - A vector containing all indices in increasing order that the substring occurs at.
+    */
+    inline std::vector<size_t> findAll(     const std::string_view & str,
+                                            const Searcher & searcher,
+                                            const bool overlapping  )
+    {
+        std::vector<size_t> positions;
+        const size_t step = overlapping ? 1 : std::max<size_t>(searcher.length(), 1);
+
+        size_t pos = searcher.find(str, 0);
+        while(pos != std::string::npos)
+        {
+            positions.push_back(pos);
+            pos = searcher.find(str, pos+step);
+        }
+
+        return positions;
+    }
+
+
+    /**
+     * Parallel variant of findAll that finds occurrences of a precompiled Searcher's needle - see
+     * the substring variant below.
+     *
+     * @param str - The std::string we are searching for the substring in.
+     * @param searcher - The Searcher for the substring we are looking for within std::string str.
+     * @param overlapping - If true, report occurrences that overlap an earlier one too.
+     * @param parallelSettings - How many threads to use, and the smallest chunk worth a thread.
+     *
+     * @retval std::vector<size_t> - A vector containing all indices in increasing order that the substring occurs at.
+    */
+    inline std::vector<size_t> findAll(     const std::string_view & str,
+                                            const Searcher & searcher,
+                                            const bool overlapping,
+                                            const ParallelSettings & parallelSettings  )
+    {
+        size_t chunkCount = detail::parallelChunkCount( str.length(),
+                                                        parallelSettings.threadCount,
+                                                        parallelSettings.minChunkSize );
+        if(chunkCount <= 1 || searcher.length() == 0)
+        {
+            return findAll(str, searcher, overlapping);
+        }
+        return detail::findAllInChunks(str, searcher.length(), overlapping, chunkCount,
+                                       [&](const std::string_view & haystack, size_t from)
+                                       {
+                                           return searcher.find(haystack, from);
+                                       });
+    }
+
+
+    /**
+     * Parallel variant of findAll, for searching very large strings (e.g. a memory-mapped dump)
+     * on several cores. str is cut into even chunks, the occurrences starting in each chunk are
+     * found on its own worker thread - each thread reads substr.length() - 1 bytes into the next
+     * chunk, so occurrences straddling a border are still found - and the positions are merged
+     * back in order. The result is always identical to findAll(str, substr, overlapping).
+     * Inputs too small to be worth splitting (see ParallelSettings) and empty substrings are
+     * searched serially.
+     *
+     * Example:
+     *
+     * std::vector<size_t> hits = findAll(dump, "ERROR", false, ParallelSettings{});
+     *
+     * @param str - The std::string we are searching for the substring in.
+     * @param substr - The substring we are looking for within std::string str.
+     * @param overlapping - If true, report occurrences that overlap an earlier one too.
+     * @param parallelSettings - How many threads to use, and the smallest chunk worth a thread.
+     *
+     * @retval std::vector<size_t> - A vector containing all indices in increasing order that the substr occurs at.
+    */
+    inline std::vector<size_t> findAll(     const std::string_view & str,
+                                            const std::string_view & substr,
+                                            const bool overlapping,
+                                            const ParallelSettings & parallelSettings  )
+    {
+        //Each worker thread searches for the same needle, so build its Searcher once up front
+        return findAll(str, Searcher(substr), overlapping, parallelSettings);
+    }
+
+
+    /**
+     * Allocation-free variant of findAll: calls visitor(index) for every index that ch occurs at
+     * in str, in increasing order, instead of collecting them into a vector. If visitor returns
+     * bool, returning false stops the search early - e.g. to take only the first N hits.
+     *
+     * Example:
+     *
+     * std::vector<size_t> firstTwo;
+     * forEachOccurrence("a,b,c,d", ',', [&](size_t index)
+     * {
+     *     firstTwo.push_back(index);
+     *     return firstTwo.size() < 2;
+     * });
+     * //firstTwo == {1, 3}
+     *
+     * @param str - The std::string we are searching for the character in.
+     * @param ch - The character we are looking for within str.
+     * @param visitor - Callable taking a size_t index, returning void or bool (false to stop).
+     *
+     * @retval bool - False if visitor stopped the search early, true otherwise.
+    */
+    template<typename Visitor>
+    inline bool forEachOccurrence(  const std::string_view & str,
+                                    const char ch,
+                                    Visitor && visitor  )
+    {
+        return detail::forEachCharPosition(str, ch, [&](size_t index)
+        {
+            return detail::callVisitor(visitor, index);
+        });
+    }
+
+
+    /**
+     * Variant of forEachOccurrence that finds occurrences of a substring. Like findAll,
+     * occurrences may overlap.
+     *
+     * @param str - The std::string we are searching for the substring in.
+     * @param substr - The substring we are looking for within str.
+     * @param visitor - Callable taking a size_t index, returning void or bool (false to stop).
+     *
+     * @retval bool - False if visitor stopped the search early, true otherwise.
+    */
+    template<typename Visitor>
+    inline bool forEachOccurrence(  const std::string_view & str,
+                                    const std::string_view & substr,
+                                    Visitor && visitor  )
+    {
+        size_t pos = str.find(substr, 0);
+        while(pos != std::string::npos)
+        {
+            if(!detail::callVisitor(visitor, pos))
+            {
+                return false;
+            }
+            pos = str.find(substr, pos+1);
+        }
+        return true;
+    }
+
+
+    /**
+     * Variant of forEachOccurrence that finds occurrences of a precompiled Searcher's needle.
+     *
+     * @param str - The std::string we are searching for the substring in.
+     * @param searcher - The Searcher for the substring we are looking for within str.
+     * @param visitor - Callable taking a size_t index, returning void or bool (false to stop).
+     *
+     * @retval bool - False if visitor stopped the search early, true otherwise.
+    */
+    template<typename Visitor>
+    inline bool forEachOccurrence(  const std::string_view & str,
+                                    const Searcher & searcher,
+                                    Visitor && visitor  )
+    {
+        size_t pos = searcher.find(str, 0);
+        while(pos != std::string::npos)
+        {
+            if(!detail::callVisitor(visitor, pos))
+            {
+                return false;
+            }
+            pos = searcher.find(str, pos+1);
+        }
+        return true;
+    }
+
+
+    /**
+     * Variant of forEachOccurrence that finds every occurrence of every pattern of a
+     * MultiPatternMatcher, in one pass over str. See MultiPatternMatcher::forEachMatch().
+     *
+     * @param str - The std::string we are searching for the patterns in.
+     * @param matcher - The compiled patterns we are looking for within str.
+     * @param visitor - Callable taking a PatternMatch, returning void or bool (false to stop).
+     *
+     * @retval bool - False if visitor stopped the search early, true otherwise.
+    */
+    template<typename Visitor>
+    inline bool forEachOccurrence(  const std::string_view & str,
+                                    const MultiPatternMatcher & matcher,
+                                    Visitor && visitor  )
+    {
+        return matcher.forEachMatch(str, visitor);
+    }
+
+
+    /**
+     * Variant of findAll that finds every occurrence of every pattern of a MultiPatternMatcher,
+     * in one pass over str rather than one findAll() call per pattern. Like the substring
+     * variant, occurrences may overlap - both of each other and of other patterns.
+     *
+     * @param str - The std::string we are searching for the patterns in.
+     * @param matcher - The compiled patterns we are looking for within str.
+     *
+     * @retval std::vector<PatternMatch> - Every (pattern id, offset) hit, in the order the hits end in str.
+    */
+    inline std::vector<PatternMatch> findAll(   const std::string_view & str,
+                                                const MultiPatternMatcher & matcher  )
+    {
+        std::vector<PatternMatch> matches;
+        matcher.forEachMatch(str, [&](const PatternMatch & match)
+        {
+            matches.push_back(match);
+        });
+        return matches;
+    }
+
+
+    /**
+     * Count the occurrences of a character in str - the same number findAll(str, ch).size() gives,
+     * without ever recording where they are. Counts 16-32 bytes at a time with a SIMD compare and
+     * a popcount of the resulting mask.
+     *
+     * @param str - The std::string we are counting the character in.
+     * @param ch - The character we are counting.
+     *
+     * @retval size_t - The number of occurrences of ch in str.
+    */
+    inline size_t countAll( const std::string_view & str,
+                            const char ch  )
+    {
+        return detail::countChar(str, ch);
+    }
+
+
+    /**
+     * Variant of countAll that counts occurrences of a substring. Like findAll, overlapping
+     * occurrences are all counted (so "aa" occurs 3 times in "aaaa").
+     *
+     * @param str - The std::string we are counting the substring in.
+     * @param substr - The substring we are counting.
+     *
+     * @retval size_t - The number of occurrences of substr in str.
+    */
+    inline size_t countAll( const std::string_view & str,
+                            const std::string_view & substr  )
+    {
+        if(substr.length() == 1)
+        {
+            return detail::countChar(str, substr[0]);
+        }
+        size_t count = 0;
+        forEachOccurrence(str, substr, [&](size_t)
+        {
+            count++;
+        });
+        return count;
+    }
+
+
+    /**
+     * Variant of countAll that counts occurrences of a precompiled Searcher's needle.
+     *
+     * @param str - The std::string we are counting the substring in.
+     * @param searcher - The Searcher for the substring we are counting.
+     *
+     * @retval size_t - The number of occurrences of the substring in str.
+    */
+    inline size_t countAll( const std::string_view & str,
+                            const Searcher & searcher  )
+    {
+        if(searcher.length() == 1)
+        {
+            return detail::countChar(str, searcher.needle()[0]);
+        }
+        size_t count = 0;
+        forEachOccurrence(str, searcher, [&](size_t)
+        {
+            count++;
+        });
+        return count;
+    }
+
+
+    /**
+     * A trigram index over a large, unchanging text, for answering many contains(), findAll() and
+     * countAll() queries against it without scanning the whole text each time (e.g. ad-hoc
+     * searches of a multi-gigabyte log dump).
+     *
+     * The text is cut into blocks of blockSize bytes, and for every trigram (3-byte sequence) the
+     * index keeps a posting list of the blocks it starts in. A query for a needle of 3 or more
+     * bytes looks up the posting lists of the needle's trigrams, keeps only the blocks where every
+     * one of them occurs at a position consistent with a single match, and then searches just
+     * those stretches of the text with a Searcher. Needles shorter than 3 bytes have no trigram
+     * to look up, and are searched for across the whole text.
+     *
+     * Memory: 4 bytes per distinct (trigram, block) pair plus 12 bytes per distinct trigram, on
+     * top of the text itself. A trigram repeated within a block is stored once, so the posting
+     * lists never take more than 4 bytes per input byte, and the trigram table is bounded by the
+     * 2^24 possible trigrams. On Frankenstein the whole index is about 2.7 bytes per input byte
+     * with the default blockSize of 1024, and about 1.7 with 4096 - larger blocks make the index
+     * smaller and each candidate block slower to check. Building it fills the posting lists in
+     * place, counting each trigram's blocks first, so beyond the finished index it only needs
+     * about 2 MB to look trigrams up, plus 2 MB and 8 bytes per distinct trigram for each thread.
+     *
+     * The index keeps a view of the text rather than a copy, so the text must outlive it.
+     *
+     * Example:
+     *
+     * const SubstringIndex index(corpus);
+     * if(index.contains("conflagration"))
+     * {
+     *     std::vector<size_t> hits = index.findAll("conflagration");
+     * }
+    */
+    class SubstringIndex
+    {
+    public:
+        /**
+         * @param text - The text to index. It must outlive the index.
+         * @param blockSize - How many bytes of text each posting list entry stands for.
+        */
+        explicit SubstringIndex(    const std::string_view & text,
+                                    const size_t blockSize = 1024  )
+            : SubstringIndex(text, ParallelSettings{1}, blockSize)
+        {
+        }
+
+        /**
+         * Variant of the constructor that builds the index on several threads - see
+         * ParallelSettings. The result is identical to a serially built index.
+         *
+         * @param text - The text to index. It must outlive the index.
+         * @param parallelSettings - How many threads to use, and the smallest chunk worth a thread.
+         * @param blockSize - How many bytes of text each posting list entry stands for.
+        */
+        SubstringIndex( const std::string_view & text,
+                        const ParallelSettings & parallelSettings,
+                        const size_t blockSize = 1024  )
+            : m_text(text),
+              m_blockSize(blockSize)
+        {
+            if(blockSize == 0)
+            {
+                throw std::invalid_argument("blockSize cannot be 0 for SubstringIndex");
+            }
+            const size_t blockCount = (text.length() + blockSize - 1) / blockSize;
+            if(blockCount > std::numeric_limits<uint32_t>::max())
+            {
+                throw std::invalid_argument("text has too many blocks for SubstringIndex, use a larger blockSize");
+            }
+            const size_t chunkCount = std::max<size_t>(1, std::min(blockCount,
+                detail::parallelChunkCount(text.length(), parallelSettings.threadCount, parallelSettings.minChunkSize)));
+
+            auto chunkBegin = [&](size_t chunk) { return blockCount * chunk / chunkCount * blockSize; };
+
+            //Mark which of the 2^24 possible trigrams occur, each thread marking its own run of blocks
+            std::vector<std::vector<uint64_t>> chunkSeen(chunkCount);
+            detail::runInParallel(chunkCount, [&](size_t chunk)
+            {
+                chunkSeen[chunk].assign(size_t(1) << 18, 0);
+                for(size_t index = chunkBegin(chunk); index + 3 <= text.length() && index < chunkBegin(chunk + 1); index++)
+                {
+                    const uint32_t trigram = trigramAt(index);
+                    chunkSeen[chunk][trigram / 64] |= uint64_t(1) << (trigram % 64);
+                }
+            });
+            detail::RankBitVector seen(size_t(1) << 24);
+            for(size_t word = 0; word < chunkSeen[0].size(); word++)
+            {
+                uint64_t bits = 0;
+                for(const std::vector<uint64_t> & marks : chunkSeen)
+                {
+                    bits |= marks[word];
+                }
+                for(size_t bit = 0; bits != 0; bit++, bits >>= 1)
+                {
+                    if(bits & 1)
+                    {
+                        m_trigrams.push_back(static_cast<uint32_t>(word * 64 + bit));
+                        seen.set(word * 64 + bit);
+                    }
+                }
+            }
+            chunkSeen.clear();
+            seen.buildRanks();
+
+            //Count each trigram's blocks, per thread. lastBlock remembers the block a trigram was
+            //last counted in (plus one), so a trigram repeated within a block is counted once
+            std::vector<std::vector<uint32_t>> chunkCounts(chunkCount);
+            std::vector<std::vector<uint32_t>> chunkLastBlock(chunkCount);
+            detail::runInParallel(chunkCount, [&](size_t chunk)
+            {
+                chunkCounts[chunk].assign(m_trigrams.size(), 0);
+                chunkLastBlock[chunk].assign(m_trigrams.size(), 0);
+                for(size_t index = chunkBegin(chunk); index + 3 <= text.length() && index < chunkBegin(chunk + 1); index++)
+                {
+                    const size_t id = seen.rank1(trigramAt(index));
+                    const uint32_t block = static_cast<uint32_t>(index / blockSize + 1);
+                    if(chunkLastBlock[chunk][id] != block)
+                    {
+                        chunkLastBlock[chunk][id] = block;
+                        chunkCounts[chunk][id]++;
+                    }
+                }
+            });
+
+            //Prefix sum the counts into where each posting list starts. Within a trigram, chunk 0's
+            //blocks come before chunk 1's and so on, so each thread's count becomes the offset its
+            //blocks start at within the list
+            m_postingStart.resize(m_trigrams.size() + 1);
+            size_t total = 0;
+            for(size_t id = 0; id < m_trigrams.size(); id++)
+            {
+                m_postingStart[id] = total;
+                uint32_t offset = 0;
+                for(std::vector<uint32_t> & counts : chunkCounts)
+                {
+                    const uint32_t count = counts[id];
+                    counts[id] = offset;
+                    offset += count;
+                }
+                total += offset;
+            }
+            m_postingStart.back() = total;
+
+            //Then fill the posting lists in place, each thread writing its own blocks
+            m_blocks.resize(total);
+            detail::runInParallel(chunkCount, [&](size_t chunk)
+            {
+                std::fill(chunkLastBlock[chunk].begin(), chunkLastBlock[chunk].end(), 0);
+                for(size_t index = chunkBegin(chunk); index + 3 <= text.length() && index < chunkBegin(chunk + 1); index++)
+                {
+                    const size_t id = seen.rank1(trigramAt(index));
+                    const uint32_t block = static_cast<uint32_t>(index / blockSize + 1);
+                    if(chunkLastBlock[chunk][id] != block)
+                    {
+                        chunkLastBlock[chunk][id] = block;
+                        m_blocks[m_postingStart[id] + chunkCounts[chunk][id]++] = block - 1;
+                    }
+                }
+            });
+            m_trigrams.shrink_to_fit();
+        }
+
+        /**
+         * @retval std::string_view - The text this index was built over.
+        */
+        std::string_view text() const
+        {
+            return m_text;
+        }
+
+        /**
+         * Call visitor(index) for every index that substr occurs at in the text, in increasing
+         * order - the same occurrences (overlaps included) forEachOccurrence(text(), substr, visitor)
+         * finds. If visitor returns bool, returning false stops the search early.
+         *
+         * @param substr - The substring to look for.
+         * @param visitor - Callable taking a size_t index, returning void or bool (false to stop).
+         *
+         * @retval bool - False if visitor stopped the search early, true otherwise.
+        */
+        template<typename Visitor>
+        bool forEachOccurrence(const std::string_view & substr, Visitor && visitor) const
+        {
+            const Searcher searcher(substr);
+            if(substr.length() < 3)
+            {
+                return searchRange(searcher, 0, m_text.length() + 1, visitor);
+            }
+
+            //Look up the posting list of every trigram of substr, with the offset it sits at
+            struct Posting
+            {
+                size_t offset;
+                const uint32_t * begin;
+                const uint32_t * end;
+            };
+            std::vector<Posting> postings;
+            for(size_t offset = 0; offset + 3 <= substr.length(); offset++)
+            {
+                const uint32_t trigram = trigramOf(substr.data() + offset);
+                auto found = std::lower_bound(m_trigrams.begin(), m_trigrams.end(), trigram);
+                if(found == m_trigrams.end() || *found != trigram)
+                {
+                    return true;
+                }
+                const size_t id = static_cast<size_t>(found - m_trigrams.begin());
+                postings.push_back({offset, m_blocks.data() + m_postingStart[id], m_blocks.data() + m_postingStart[id + 1]});
+            }
+            std::sort(postings.begin(), postings.end(), [](const Posting & a, const Posting & b)
+            {
+                return (a.end - a.begin) < (b.end - b.begin);
+            });
+
+            //Walk the rarest trigram's blocks. A match starting at s puts trigram j at s + offset_j,
+            //so for the match starts a block allows, every other trigram must occur in the blocks
+            //those starts put it in
+            const Posting & rarest = postings[0];
+            for(const uint32_t * block = rarest.begin; block != rarest.end; block++)
+            {
+                const size_t blockStart = size_t(*block) * m_blockSize;
+                if(blockStart + m_blockSize <= rarest.offset)
+                {
+                    continue;
+                }
+                const size_t startsBegin = (blockStart >= rarest.offset) ? blockStart - rarest.offset : 0;
+                const size_t startsEnd = blockStart + m_blockSize - rarest.offset;
+                bool candidate = true;
+                for(size_t other = 1; other < postings.size() && candidate; other++)
+                {
+                    const uint32_t firstBlock = static_cast<uint32_t>((startsBegin + postings[other].offset) / m_blockSize);
+                    const uint32_t lastBlock = static_cast<uint32_t>((startsEnd - 1 + postings[other].offset) / m_blockSize);
+                    const uint32_t * found = std::lower_bound(postings[other].begin, postings[other].end, firstBlock);
+                    candidate = (found != postings[other].end && *found <= lastBlock);
+                }
+                if(candidate && !searchRange(searcher, startsBegin, startsEnd, visitor))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @param substr - The substring to look for.
+         *
+         * @retval bool - True if substr occurs somewhere in the text, the same as contains(text(), substr).
+        */
+        bool contains(const std::string_view & substr) const
+        {
+            return !forEachOccurrence(substr, [](size_t)
+            {
+                return false;
+            });
+        }
+
+        /**
+         * @param substr - The substring to look for.
+         *
+         * @retval std::vector<size_t> - Every index in increasing order that substr occurs at in the
+         *         text, overlaps included - the same as findAll(text(), substr).
+        */
+        std::vector<size_t> findAll(const std::string_view & substr) const
+        {
+            std::vector<size_t> positions;
+            forEachOccurrence(substr, [&](size_t index)
+            {
+                positions.push_back(index);
+            });
+            return positions;
+        }
+
+        /**
+         * @param substr - The substring to look for.
+         *
+         * @retval size_t - The number of occurrences of substr in the text, overlaps included -
+         *         the same as countAll(text(), substr).
+        */
+        size_t countAll(const std::string_view & substr) const
+        {
+            size_t count = 0;
+            forEachOccurrence(substr, [&](size_t)
+            {
+                count++;
+            });
+            return count;
+        }
+
+        /**
+         * @retval size_t - The bytes the index itself takes up, not counting the text.
+        */
+        size_t memoryUsage() const
+        {
+            return m_trigrams.capacity() * sizeof(uint32_t)
+                 + m_postingStart.capacity() * sizeof(size_t)
+                 + m_blocks.capacity() * sizeof(uint32_t);
+        }
+
+    private:
+        static uint32_t trigramOf(const char * bytes)
+        {
+            return (uint32_t(static_cast<unsigned char>(bytes[0])) << 16)
+                 | (uint32_t(static_cast<unsigned char>(bytes[1])) << 8)
+                 |  uint32_t(static_cast<unsigned char>(bytes[2]));
+        }
+
+        uint32_t trigramAt(size_t index) const
+        {
+            return trigramOf(m_text.data() + index);
+        }
+
+        /**
+         * Visit every occurrence of searcher's needle in the text starting at an index in
+         * [startsBegin, startsEnd).
+        */
+        template<typename Visitor>
+        bool searchRange(const Searcher & searcher, size_t startsBegin, size_t startsEnd, Visitor & visitor) const
+        {
+            if(startsBegin > m_text.length())
+            {
+                return true;
+            }
+            const std::string_view window = m_text.substr(startsBegin, startsEnd - startsBegin + searcher.length() - 1);
+            size_t pos = searcher.find(window, 0);
+            while(pos != std::string_view::npos && startsBegin + pos < startsEnd)
+            {
+                if(!detail::callVisitor(visitor, startsBegin + pos))
+                {
+                    return false;
+                }
+                pos = searcher.find(window, pos + 1);
+            }
+            return true;
+        }
+
+        std::string_view m_text;
+        size_t m_blockSize;
+        std::vector<uint32_t> m_trigrams;     // every distinct trigram of the text, sorted
+        std::vector<size_t> m_postingStart;   // m_blocks[m_postingStart[i], m_postingStart[i + 1]) are m_trigrams[i]'s blocks
+        std::vector<uint32_t> m_blocks;
+    };
+
+
+    /**
+     * The suffix array of a large, unchanging text - the start index of every suffix of the text,
+     * in sorted order - for answering count and locate queries on arbitrary substrings at
+     * interactive speed. Every occurrence of a substring starts one of a contiguous run of sorted
+     * suffixes, which two binary searches find: countAll() takes O(m log n) time for an m-byte
+     * substring of an n-byte text, and findAll() adds O(k log k) to sort the k hits by index.
+     *
+     * Built in linear time with SA-IS. Memory: 4 bytes per input byte, on top of the text itself
+     * (which the array keeps a view of, so the text must outlive it); building it briefly needs
+     * about 12 more bytes per input byte. Texts of 2^31 - 1 bytes or more are not supported. For
+     * a smaller index that answers counts without the text, see FMIndex.
+     *
+     * Example:
+     *
+     * const SuffixArray suffixArray(corpus);
+     * size_t mentions = suffixArray.countAll("Elizabeth");
+    */
+    class SuffixArray
+    {
+    public:
+        /**
+         * @param text - The text to index. It must outlive the suffix array.
+        */
+        explicit SuffixArray(const std::string_view & text)
+            : m_text(text)
+        {
+            if(text.length() >= static_cast<size_t>(std::numeric_limits<int32_t>::max()))
+            {
+                throw std::invalid_argument("text is too long for SuffixArray");
+            }
+            std::vector<int32_t> symbols(text.begin(), text.end());
+            for(int32_t & symbol : symbols)
+            {
+                symbol = static_cast<unsigned char>(symbol);
+            }
+            m_suffixes = detail::suffixArraySais(symbols, 255);
+        }
+
+        /**
+         * @retval std::string_view - The text this suffix array was built over.
+        */
+        std::string_view text() const
+        {
+            return m_text;
+        }
+
+        /**
+         * @retval const std::vector<int32_t> & - The start index of every suffix of the text, in sorted order.
+        */
+        const std::vector<int32_t> & suffixes() const
+        {
+            return m_suffixes;
+        }
+
+        /**
+         * Find the run of sorted suffixes that begin with substr, by binary search.
+         *
+         * @param substr - The substring to look for.
+         *
+         * @retval std::pair<size_t, size_t> - The [first, last) range of suffixes() starting with substr.
+        */
+        std::pair<size_t, size_t> suffixRange(const std::string_view & substr) const
+        {
+            auto prefixOf = [&](int32_t suffix)
+            {
+                return m_text.substr(static_cast<size_t>(suffix), substr.length());
+            };
+            auto first = std::lower_bound(m_suffixes.begin(), m_suffixes.end(), substr, [&](int32_t suffix, const std::string_view & value)
+            {
+                return prefixOf(suffix) < value;
+            });
+            auto last = std::upper_bound(first, m_suffixes.end(), substr, [&](const std::string_view & value, int32_t suffix)
+            {
+                return value < prefixOf(suffix);
+            });
+            return {static_cast<size_t>(first - m_suffixes.begin()), static_cast<size_t>(last - m_suffixes.begin())};
+        }
+
+        /**
+         * @param substr - The substring to count.
+         *
+         * @retval size_t - The number of occurrences of substr in the text, overlaps included -
+         *         the same as countAll(text(), substr).
+        */
+        size_t countAll(const std::string_view & substr) const
+        {
+            if(substr.empty())
+            {
+                return m_text.length() + 1;
+            }
+            const std::pair<size_t, size_t> range = suffixRange(substr);
+            return range.second - range.first;
+        }
+
+        /**
+         * @param substr - The substring to look for.
+         *
+         * @retval bool - True if substr occurs somewhere in the text, the same as contains(text(), substr).
+        */
+        bool contains(const std::string_view & substr) const
+        {
+            return substr.empty() || countAll(substr) > 0;
+        }
+
+        /**
+         * @param substr - The substring to look for.
+         *
+         * @retval std::vector<size_t> - Every index in increasing order that substr occurs at in the
+         *         text, overlaps included - the same as findAll(text(), substr).
+        */
+        std::vector<size_t> findAll(const std::string_view & substr) const
+        {
+            std::vector<size_t> positions;
+            if(substr.empty())
+            {
+                positions.resize(m_text.length() + 1);
+                for(size_t index = 0; index < positions.size(); index++)
+                {
+                    positions[index] = index;
+                }
+                return positions;
+            }
+            const std::pair<size_t, size_t> range = suffixRange(substr);
+            positions.assign(m_suffixes.begin() + range.first, m_suffixes.begin() + range.second);
+            std::sort(positions.begin(), positions.end());
+            return positions;
+        }
+
+        /**
+         * @retval size_t - The bytes the suffix array itself takes up, not counting the text.
+        */
+        size_t memoryUsage() const
+        {
+            return m_suffixes.capacity() * sizeof(int32_t);
+        }
+
+    private:
+        std::string_view m_text;
+        std::vector<int32_t> m_suffixes;
+    };
+
+
+    /**
+     * An FM-index: a compressed form of a SuffixArray that answers the same count and locate
+     * queries in less memory, and without needing the text at all afterwards.
+     *
+     * It stores the Burrows-Wheeler transform of the text (the byte before each sorted suffix)
+     * as a wavelet matrix, so countAll() is a backward search - 2 rank queries per byte of the
+     * substring, O(m) in the substring's length and independent of the text's. To locate hits,
+     * the suffix array is kept only at every sampleRate-th text position; findAll() steps each
+     * hit back through the transform to the nearest sample, at most sampleRate - 1 steps.
+     *
+     * Memory: about 1.125 bytes per input byte for the transform, plus about 0.14 bytes for
+     * which suffixes are sampled and 4 / sampleRate bytes for the samples themselves - about 1.4
+     * bytes per input byte at the default sampleRate of 32. A larger sampleRate makes the index
+     * smaller and findAll() slower. Building one from text builds a SuffixArray first.
+     *
+     * Example:
+     *
+     * const FMIndex index(corpus);
+     * size_t mentions = index.countAll("Elizabeth");
+    */
+    class FMIndex
+    {
+    public:
+        /**
+         * @param text - The text to index. It's not needed once the index is built.
+         * @param sampleRate - Keep the suffix array at every sampleRate-th text position.
+        */
+        explicit FMIndex(   const std::string_view & text,
+                            const size_t sampleRate = 32  )
+            : FMIndex(SuffixArray(text), sampleRate)
+        {
+        }
+
+        /**
+         * Variant of the constructor that compresses an existing SuffixArray, which can be thrown
+         * away (along with its text) afterwards.
+         *
+         * @param suffixArray - The suffix array of the text to index.
+         * @param sampleRate - Keep the suffix array at every sampleRate-th text position.
+        */
+        explicit FMIndex(   const SuffixArray & suffixArray,
+                            const size_t sampleRate = 32  )
+            : m_length(suffixArray.text().length()),
+              m_sampleRate(sampleRate)
+        {
+            if(sampleRate == 0)
+            {
+                throw std::invalid_argument("sampleRate cannot be 0 for FMIndex");
+            }
+            const std::string_view text = suffixArray.text();
+            const std::vector<int32_t> & suffixes = suffixArray.suffixes();
+
+            //Row 0 is the empty suffix (the end of text, sorting first), then every other suffix
+            //in order. A row's transform byte is the one before its suffix - none for the whole
+            //text's row, which holds a 0 that rank() discounts
+            const size_t rowCount = m_length + 1;
+            std::vector<unsigned char> transform(rowCount);
+            m_sampled = detail::RankBitVector(rowCount);
+            auto suffixOfRow = [&](size_t row)
+            {
+                return (row == 0) ? m_length : static_cast<size_t>(suffixes[row - 1]);
+            };
+            for(size_t row = 0; row < rowCount; row++)
+            {
+                const size_t suffix = suffixOfRow(row);
+                if(suffix == 0)
+                {
+                    m_wholeTextRow = row;
+                    transform[row] = 0;
+                }
+                else
+                {
+                    transform[row] = static_cast<unsigned char>(text[suffix - 1]);
+                }
+                if(suffix % sampleRate == 0)
+                {
+                    m_sampled.set(row);
+                    m_samples.push_back(static_cast<uint32_t>(suffix));
+                }
+            }
+            m_sampled.buildRanks();
+            m_samples.shrink_to_fit();
+
+            //Rows of suffixes starting with byte c begin after the empty suffix and every suffix
+            //starting with a smaller byte
+            size_t counts[256] = {};
+            for(const char ch : text)
+            {
+                counts[static_cast<unsigned char>(ch)]++;
+            }
+            m_firstRow[0] = 1;
+            for(size_t byte = 0; byte < 256; byte++)
+            {
+                m_firstRow[byte + 1] = m_firstRow[byte] + counts[byte];
+            }
+            m_transform = detail::ByteWaveletMatrix(std::move(transform));
+        }
+
+        /**
+         * @retval size_t - The length in bytes of the text this index was built over.
+        */
+        size_t length() const
+        {
+            return m_length;
+        }
+
+        /**
+         * @retval size_t - How far apart the text positions whose suffix array entry is kept are.
+        */
+        size_t sampleRate() const
+        {
+            return m_sampleRate;
+        }
+
+        /**
+         * @param substr - The substring to count.
+         *
+         * @retval size_t - The number of occurrences of substr in the text, overlaps included -
+         *         the same as countAll(text, substr).
+        */
+        size_t countAll(const std::string_view & substr) const
+        {
+            const std::pair<size_t, size_t> rows = rowRange(substr);
+            return rows.second - rows.first;
+        }
+
+        /**
+         * @param substr - The substring to look for.
+         *
+         * @retval bool - True if substr occurs somewhere in the text, the same as contains(text, substr).
+        */
+        bool contains(const std::string_view & substr) const
+        {
+            return countAll(substr) > 0;
+        }
+
+        /**
+         * @param substr - The substring to look for.
+         *
+         * @retval std::vector<size_t> - Every index in increasing order that substr occurs at in the
+         *         text, overlaps included - the same as findAll(text, substr).
+        */
+        std::vector<size_t> findAll(const std::string_view & substr) const
+        {
+            const std::pair<size_t, size_t> rows = rowRange(substr);
+            std::vector<size_t> positions;
+            positions.reserve(rows.second - rows.first);
+            for(size_t row = rows.first; row < rows.second; row++)
+            {
+                positions.push_back(locate(row));
+            }
+            std::sort(positions.begin(), positions.end());
+            return positions;
+        }
+
+        /**
+         * @retval size_t - The bytes the index takes up.
+        */
+        size_t memoryUsage() const
+        {
+            return m_transform.memoryUsage() + m_sampled.memoryUsage() + m_samples.capacity() * sizeof(uint32_t);
+        }
+
+    private:
+        /**
+         * Backward search: the [first, last) rows whose suffixes start with substr.
+        */
+        std::pair<size_t, size_t> rowRange(const std::string_view & substr) const
+        {
+            size_t first = 0;
+            size_t last = m_length + 1;
+            for(size_t index = substr.length(); index > 0 && first < last; index--)
+            {
+                const unsigned char byte = static_cast<unsigned char>(substr[index - 1]);
+                first = m_firstRow[byte] + rank(byte, first);
+                last = m_firstRow[byte] + rank(byte, last);
+            }
+            return {first, std::max(first, last)};
+        }
+
+        /**
+         * How many times byte is the transform byte of a row before row.
+        */
+        size_t rank(unsigned char byte, size_t row) const
+        {
+            size_t count = m_transform.rank(byte, row);
+            if(byte == 0 && m_wholeTextRow < row)
+            {
+                count--;
+            }
+            return count;
+        }
+
+        /**
+         * The text index of row's suffix: step to the row of the suffix one byte earlier until
+         * landing on a sampled row.
+        */
+        size_t locate(size_t row) const
+        {
+            size_t steps = 0;
+            while(!m_sampled.get(row))
+            {
+                const unsigned char byte = m_transform.at(row);
+                row = m_firstRow[byte] + rank(byte, row);
+                steps++;
+            }
+            return size_t(m_samples[m_sampled.rank1(row)]) + steps;
+        }
+
+        size_t m_length;
+        size_t m_sampleRate;
+        size_t m_wholeTextRow = 0;
+        size_t m_firstRow[257];
+        detail::ByteWaveletMatrix m_transform;
+        detail::RankBitVector m_sampled;  // rows whose suffix starts at a multiple of m_sampleRate
+        std::vector<uint32_t> m_samples;  // those suffixes' text indices, in row order
+    };
+
+
+    /**
+     * Separates a std::string by a separator character. Returns a vector of strings that were separated.
+     * 
+     * Example:
+     * 
      * std::vector<std::string> result = separate("John,Gina,Sebastian,Nick");
      * 
      * //Value of result is: {"John","Gina","Sebastian","Nick"}
      * 
      * @param str - The std::string we intend to separate with this function.
      * @param separator - The char we intend to separate str by.
-     * @param omitEmptyStrings - If true, do not include empty strings in the returned vector.
+     * @param omitEmptyStrings - If true, do not include empty strings in the returned vector.
+     *
+     * @retval std::vector<std::string> - A vector of substrings of the original string that have been split up by all occurrences of the separator parameter
+     */
+    inline std::vector<std::string> separate(   const std::string_view & str,
+                                                const char separator = ',',
+                                                const bool omitEmptyStrings = true  )
+    {
+        //If we are given an empty string, just return an empty vector
+        if(str.empty())
+        {
+            return {};
+        }
+
+        //Find every separator in one vectorized pass (see detail::forEachCharPosition()), pushing back
+        //whatever we jumped over since the previous separator as we go. Empty strings are filtered out
+        //right here instead of in a second std::remove() pass over the finished vector. Counting the
+        //separators first (far cheaper than building the strings) lets us size the vector exactly once.
+        std::vector<std::string> separatedStringsVec;
+        separatedStringsVec.reserve(detail::countChar(str, separator) + 1);
+        detail::forEachSeparatedPiece(str, separator, omitEmptyStrings, [&](const std::string_view & piece)
+        {
+            separatedStringsVec.emplace_back(piece);
+        });
+
+        return separatedStringsVec;
+    }
+
+
+    /**
+     * 
+     * 
+     * Variant of separate that lets you separate by strings instead of chars.
+     * 
+     * Separates a std::string by a separator substring. Returns a vector of strings that 
+     * were separated by the separator substring.
+     * 
+     * Example:
+     * 
+     * std::vector<std::string> result = separate("Wakko and Yakko and Dot", " and ");
+     * 
+     * //Value of result is: {"Wakko","Yakko","Dot"}
+     *
+     * @param str - The std::string we intend to separate with this function.
+     * @param separator - The substring of str we intend to separate it by.
+     * @param omitEmptyStrings - If true, do not include empty strings in the returned vector.
+     *
+     * @retval std::vector<std::string> - A vector of substrings of the original string that have been split up by all occurrences of the separator parameter
+     */
+    inline std::vector<std::string> separate(   const std::string_view & str,
+                                                const std::string_view & separator,
+                                                const bool omitEmptyStrings = true  )
+    {
+        //If we have a single character separator, we can use a more efficient method
+        if(separator.length() == 1)
+        {
+            return stevensStringLib::separate( str, separator[0], omitEmptyStrings );
+        }
+
+        //If separator is empty, split into individual characters (codepoints, not bytes - a raw
+        //byte-by-byte split would shred a multi-byte character, e.g. Cyrillic/CJK, into invalid
+        //fragments). Walks the original UTF-8 bytes once (skipping through ASCII runs 16-32 bytes
+        //at a time, via utf8::next() only for multi-byte characters) and slices each codepoint's
+        //byte range directly out of str - no need to decode into a std::u32string and re-encode
+        //each codepoint back to UTF-8, since we never need the decoded codepoint value itself,
+        //only where each character starts and ends.
+        std::vector<std::string> separatedStrings;
+        if(separator.empty())
+        {
+            separatedStrings.reserve(str.length()); // upper bound - codepoints <= bytes
+        }
+        else
+        {
+            separatedStrings.reserve(8); // Reasonable default to avoid vector reallocations
+        }
+
+        //Construct each std::string directly in vector memory from a view of str - no temporary objects
+        detail::forEachSeparatedPiece(str, separator, omitEmptyStrings, [&](const std::string_view & piece)
+        {
+            separatedStrings.emplace_back(piece);
+        });
+
+        return separatedStrings;
+    }
+
+
+    /**
+     * Variant of separate that splits on any char of a set of delimiters, rather than one single
+     * char or substring - the whole set is matched in one linear pass over str, instead of
+     * chaining one separate() call per delimiter.
+     *
+     * Example:
+     *
+     * std::vector<std::string> result = separate("red, green;blue\tcyan", CharSet(" ,;\t"));
+     *
+     * //Value of result is: {"red","green","blue","cyan"}
+     *
+     * @param str - The std::string we intend to separate with this function.
+     * @param separators - The set of chars, any one of which separates str.
+     * @param omitEmptyStrings - If true, do not include empty strings in the returned vector.
+     *
+     * @retval std::vector<std::string> - A vector of substrings of the original string that have been split up by
+     *         all occurrences of any char in separators.
+     */
+    inline std::vector<std::string> separate(   const std::string_view & str,
+                                                const CharSet & separators,
+                                                const bool omitEmptyStrings = true  )
+    {
+        //Same as the single char variant - an empty string has no pieces
+        if(str.empty())
+        {
+            return {};
+        }
+
+        std::vector<std::string> separatedStrings;
+        detail::forEachSeparatedPiece(str, separators.tables(), omitEmptyStrings, [&](const std::string_view & piece)
+        {
+            separatedStrings.emplace_back(piece);
+        });
+
+        return separatedStrings;
+    }
+
+
+    /**
+     * Variant of separate that separates by a precompiled Searcher's needle - gives the same
+     * result as separate(str, searcher.needle(), omitEmptyStrings), but without redoing any of
+     * the needle's preprocessing on every call.
+     *
+     * @param str - The std::string we intend to separate with this function.
+     * @param separator - The Searcher for the substring we intend to separate str by.
+     * @param omitEmptyStrings - If true, do not include empty strings in the returned vector.
+     *
+     * @retval std::vector<std::string> - A vector of substrings of the original string that have been split up by
+     *         all occurrences of the separator parameter.
+     */
+    inline std::vector<std::string> separate(   const std::string_view & str,
+                                                const Searcher & separator,
+                                                const bool omitEmptyStrings = true  )
+    {
+        //Single char and empty separators have their own paths already
+        if(separator.length() <= 1)
+        {
+            return stevensStringLib::separate(str, std::string_view(separator.needle()), omitEmptyStrings);
+        }
+
+        std::vector<std::string> separatedStrings;
+        separatedStrings.reserve(8);
+        detail::forEachFoundSeparatedPiece( str,
+                                            separator.length(),
+                                            [&](size_t from) { return separator.find(str, from); },
+                                            omitEmptyStrings,
+                                            [&](const std::string_view & piece)
+                                            {
+                                                separatedStrings.emplace_back(piece);
+                                            }   );
+
+        return separatedStrings;
+    }
+
+
+    /**
+     * Variant of separate with the separator fixed at compile time, as template arguments - one
+     * char for a char separator, several for a substring. Gives the same result as the
+     * runtime-argument separate(), but the scanning loop is generated for that exact separator:
+     * its chars are constants, and a multi-char separator is matched with one unrolled compare
+     * per char rather than a general substring search.
+     *
+     * Example:
+     *
+     * std::vector<std::string> fields = separate<','>("John,Gina,Sebastian");
+     * std::vector<std::string> scopes = separate<':', ':'>("std::chrono::seconds");
+     *
+     * //Value of fields is: {"John","Gina","Sebastian"}, and of scopes: {"std","chrono","seconds"}
+     *
+     * @param str - The std::string we intend to separate with this function.
+     * @param omitEmptyStrings - If true, do not include empty strings in the returned vector.
+     *
+     * @retval std::vector<std::string> - A vector of substrings of the original string that have been split up by
+     *         all occurrences of the separator.
+    */
+    template<char FirstSeparatorChar, char... OtherSeparatorChars>
+    inline std::vector<std::string> separate(   const std::string_view & str,
+                                                const bool omitEmptyStrings = true  )
+    {
+        //The first char is its own parameter so the separator can never be deduced as empty - a
+        //call like separate("a b", " ") must keep resolving to the runtime-argument overloads
+        constexpr char separator[] = {FirstSeparatorChar, OtherSeparatorChars...};
+        constexpr size_t separatorLength = sizeof(separator);
+
+        if constexpr(separatorLength == 1)
+        {
+            //The single char path is inlined with separator[0] as a constant already
+            return stevensStringLib::separate(str, separator[0], omitEmptyStrings);
+        }
+        else
+        {
+            std::vector<std::string> separatedStrings;
+            separatedStrings.reserve(8);
+            detail::forEachFoundSeparatedPiece( str,
+                                                separatorLength,
+                                                [&](size_t from)
+                                                {
+                                                    return detail::findFixedSeparator<  FirstSeparatorChar,
+                                                                                        OtherSeparatorChars...>(str, from);
+                                                },
+                                                omitEmptyStrings,
+                                                [&](const std::string_view & piece)
+                                                {
+                                                    separatedStrings.emplace_back(piece);
+                                                }   );
+            return separatedStrings;
+        }
+    }
+
+
+    /**
+     * Separates str into its individual characters (whole codepoints, like separate(str, "")), as
+     * std::string_views into str instead of one std::string per character - no allocation beyond
+     * the returned vector. Runs of plain ASCII are detected 16-32 bytes at a time, so splitting a
+     * mostly-ASCII corpus costs little more than reading it.
+     *
+     * Example:
+     *
+     * std::vector<std::string_view> chars = separateCodepoints("añb");
+     * //chars == {"a", "ñ", "b"}, with "ñ" the two bytes of that character in the original string
+     *
+     * @param str - The UTF-8 string to separate. Must outlive the returned views.
+     *
+     * @retval std::vector<std::string_view> - One view per codepoint of str, in order.
+    */
+    inline std::vector<std::string_view> separateCodepoints(const std::string_view & str)
+    {
+        //Every codepoint starts with a byte that isn't a continuation byte (10xxxxxx), so counting
+        //those sizes the vector exactly for valid UTF-8 (invalid UTF-8 throws before overrunning
+        //it). Then write by index - a plain store per codepoint instead of push_back()'s capacity
+        //check, which dominated the loop
+        size_t leadBytes = 0;
+        for(const char ch : str)
+        {
+            leadBytes += (static_cast<unsigned char>(ch) & 0xC0) != 0x80;
+        }
+        std::vector<std::string_view> codepoints(leadBytes);
+        size_t codepointCount = 0;
+        detail::forEachCodepoint(str, [&](const std::string_view & codepoint)
+        {
+            codepoints[codepointCount++] = codepoint;
+        });
+        codepoints.resize(codepointCount);
+        return codepoints;
+    }
+
+
+    /**
+     * The result of separateN(): the pieces that were separated off, in the order they appear in
+     * the original string, and the remainder of the string that was never scanned. Both view the
+     * original string.
+    */
+    struct SeparateNResult
+    {
+        std::vector<std::string_view> pieces;
+        std::string_view remainder;
+    };
+
+
+    /**
+     * Bounded variant of separate: separates off at most maxPieces pieces, starting from either
+     * side of str, and stops scanning as soon as it has them - the rest of str is returned
+     * untouched as the remainder. Useful for picking the first (or last) few fields off long lines
+     * without separating the whole line. Pieces and remainder are views into str.
+     *
+     * Example:
+     *
+     * SeparateNResult first = separateN("2024-05-01 12:00:00 INFO server started", ' ', 2);
+     * //first.pieces == {"2024-05-01", "12:00:00"}, first.remainder == "INFO server started"
+     *
+     * SeparateNResult last = separateN("/usr/local/bin/tool", '/', 1, "right");
+     * //last.pieces == {"tool"}, last.remainder == "/usr/local/bin"
+     *
+     * @param str - The std::string we intend to separate. Must outlive the returned views.
+     * @param separator - The char we intend to separate str by.
+     * @param maxPieces - The most pieces to separate off. If str runs out first, all of its
+     *                    pieces are returned and the remainder is empty.
+     * @param startFrom - The side of str to start separating from. Valid values are "left" and "right".
+     * @param omitEmptyStrings - If true, empty pieces are skipped and don't count towards maxPieces.
+     *
+     * @retval SeparateNResult - The pieces, in the order they appear in str, and the unscanned remainder.
+    */
+    inline SeparateNResult separateN(   const std::string_view & str,
+                                        const char separator,
+                                        const size_t maxPieces,
+                                        const std::string & startFrom = "left",
+                                        const bool omitEmptyStrings = true  )
+    {
+        //Same as separate() - an empty string has no pieces
+        if(str.empty())
+        {
+            return {{}, str};
+        }
+
+        SeparateNResult result;
+        if(startFrom == "left")
+        {
+            size_t remainderStart = detail::separateNFromLeft(str, 1, [&](size_t from)
+            {
+                return str.find(separator, from);
+            }, maxPieces, omitEmptyStrings, result.pieces);
+            result.remainder = str.substr(remainderStart);
+        }
+        else if(startFrom == "right")
+        {
+            size_t remainderEnd = detail::separateNFromRight(str, 1, [&](size_t end)
+            {
+                return (end == 0) ? std::string_view::npos : str.rfind(separator, end - 1);
+            }, maxPieces, omitEmptyStrings, result.pieces);
+            result.remainder = str.substr(0, remainderEnd);
+        }
+        else
+        {
+            throw std::invalid_argument("startFrom must be \"left\" or \"right\" for separateN()");
+        }
+        return result;
+    }
+
+
+    /**
+     * Variant of separateN that lets you separate by strings instead of chars. Going from the right,
+     * a separator that can overlap itself (e.g. "::" in ":::") is matched at its rightmost
+     * occurrence, so the split can differ from separating the same text from the left.
+     *
+     * @param str - The std::string we intend to separate. Must outlive the returned views.
+     * @param separator - The substring we intend to separate str by. Can't be empty.
+     * @param maxPieces - The most pieces to separate off. If str runs out first, all of its
+     *                    pieces are returned and the remainder is empty.
+     * @param startFrom - The side of str to start separating from. Valid values are "left" and "right".
+     * @param omitEmptyStrings - If true, empty pieces are skipped and don't count towards maxPieces.
+     *
+     * @retval SeparateNResult - The pieces, in the order they appear in str, and the unscanned remainder.
+    */
+    inline SeparateNResult separateN(   const std::string_view & str,
+                                        const std::string_view & separator,
+                                        const size_t maxPieces,
+                                        const std::string & startFrom = "left",
+                                        const bool omitEmptyStrings = true  )
+    {
+        if(separator.empty())
+        {
+            throw std::invalid_argument("separator cannot be empty for separateN()");
+        }
+        if(separator.length() == 1)
+        {
+            return separateN(str, separator[0], maxPieces, startFrom, omitEmptyStrings);
+        }
+
+        //Same as separate() - an empty string is one empty piece, unless those are omitted
+        SeparateNResult result;
+        if(startFrom == "left")
+        {
+            size_t remainderStart = detail::separateNFromLeft(str, separator.length(), [&](size_t from)
+            {
+                return str.find(separator, from);
+            }, maxPieces, omitEmptyStrings, result.pieces);
+            result.remainder = str.substr(remainderStart);
+        }
+        else if(startFrom == "right")
+        {
+            size_t remainderEnd = detail::separateNFromRight(str, separator.length(), [&](size_t end)
+            {
+                return (end < separator.length()) ? std::string_view::npos
+                                                  : str.rfind(separator, end - separator.length());
+            }, maxPieces, omitEmptyStrings, result.pieces);
+            result.remainder = str.substr(0, remainderEnd);
+        }
+        else
+        {
+            throw std::invalid_argument("startFrom must be \"left\" or \"right\" for separateN()");
+        }
+        return result;
+    }
+
+
+    /**
+     * Parallel variant of separate, for separating very large strings (e.g. a whole file body) on
+     * several cores. str is cut into chunks that each end exactly where a separator starts, every
+     * chunk is separated on its own worker thread, and the pieces are stitched back together in
+     * order - the result is always identical to separate(str, separator, omitEmptyStrings).
+     * Inputs too small to be worth splitting (see ParallelSettings) are separated serially.
+     *
+     * Example:
+     *
+     * std::vector<std::string> lines = separate(fileBody, '\n', true, ParallelSettings{});
+     *
+     * @param str - The std::string we intend to separate with this function.
+     * @param separator - The char we intend to separate str by.
+     * @param omitEmptyStrings - If true, do not include empty strings in the returned vector.
+     * @param parallelSettings - How many threads to use, and the smallest chunk worth a thread.
+     *
+     * @retval std::vector<std::string> - A vector of substrings of the original string that have been split up by
+     *         all occurrences of the separator parameter.
+     */
+    inline std::vector<std::string> separate(   const std::string_view & str,
+                                                const char separator,
+                                                const bool omitEmptyStrings,
+                                                const ParallelSettings & parallelSettings  )
+    {
+        size_t chunkCount = detail::parallelChunkCount( str.length(),
+                                                        parallelSettings.threadCount,
+                                                        parallelSettings.minChunkSize );
+        if(chunkCount <= 1)
+        {
+            return stevensStringLib::separate(str, separator, omitEmptyStrings);
+        }
+
+        //Any occurrence of a single char separator is one separate() splits on
+        auto findSeparator = [&](size_t from, size_t)
+        {
+            size_t index = str.find(separator, from);
+            return std::make_pair(index, index + 1);
+        };
+        auto separateChunk = [&](const std::string_view & chunk, auto && visitor)
+        {
+            detail::forEachSeparatedPiece(chunk, separator, omitEmptyStrings, visitor);
+        };
+        return detail::separateInChunks(str, chunkCount, findSeparator, separateChunk);
+    }
+
+
+    /**
+     * Parallel variant of separate that lets you separate by strings instead of chars - see the
+     * char variant. An empty separator (split into codepoints) is always done serially.
+     *
+     * A separator that can overlap itself (e.g. "::" in ":::") has occurrences separate() never
+     * splits on, because scanning resumes after the previous separator. A chunk is only ever cut
+     * at an occurrence no other occurrence overlaps from the left, which separate() is guaranteed
+     * to split on too - so chunked and serial results still agree exactly.
+     *
+     * @param str - The std::string we intend to separate with this function.
+     * @param separator - The substring of str we intend to separate it by.
+     * @param omitEmptyStrings - If true, do not include empty strings in the returned vector.
+     * @param parallelSettings - How many threads to use, and the smallest chunk worth a thread.
+     *
+     * @retval std::vector<std::string> - A vector of substrings of the original string that have been split up by
+     *         all occurrences of the separator parameter.
+     */
+    inline std::vector<std::string> separate(   const std::string_view & str,
+                                                const std::string_view & separator,
+                                                const bool omitEmptyStrings,
+                                                const ParallelSettings & parallelSettings  )
+    {
+        if(separator.length() == 1)
+        {
+            return stevensStringLib::separate(str, separator[0], omitEmptyStrings, parallelSettings);
+        }
+        size_t chunkCount = detail::parallelChunkCount( str.length(),
+                                                        parallelSettings.threadCount,
+                                                        parallelSettings.minChunkSize );
+        if(chunkCount <= 1 || separator.empty())
+        {
+            return stevensStringLib::separate(str, separator, omitEmptyStrings);
+        }
+
+        auto findSeparator = [&](size_t from, size_t chunkStart)
+        {
+            size_t index = str.find(separator, from);
+            while(index != std::string_view::npos)
+            {
+                //Usable only if no occurrence starting after chunkStart (where the serial scan is
+                //known to resume) overlaps this one from the left
+                size_t windowStart = std::max(chunkStart, index - std::min(index, separator.length() - 1));
+                std::string_view window = str.substr(windowStart, index - windowStart + separator.length() - 1);
+                if(window.find(separator) == std::string_view::npos)
+                {
+                    return std::make_pair(index, index + separator.length());
+                }
+                index = str.find(separator, index + 1);
+            }
+            return std::make_pair(index, index);
+        };
+        auto separateChunk = [&](const std::string_view & chunk, auto && visitor)
+        {
+            detail::forEachSeparatedPiece(chunk, separator, omitEmptyStrings, visitor);
+        };
+        return detail::separateInChunks(str, chunkCount, findSeparator, separateChunk);
+    }
+
+
+    /**
+     * Variant of separate that writes the separated pieces into a container you own instead of
+     * returning a new vector, for hot loops that separate many strings one after another (e.g.
+     * parsing a file line by line). Afterwards out holds exactly the pieces separate() would have
+     * returned.
+     *
+     * out's existing elements are overwritten in place rather than cleared and rebuilt: the vector
+     * keeps its capacity, and std::string elements keep their heap buffers (std::string::assign()
+     * only reallocates when a piece outgrows the buffer it lands in). Once the loop has seen its
+     * longest pieces, separating lines with the same number of pieces allocates nothing at all.
+     * Elements left over past the last piece are erased, which releases their buffers - so a line
+     * with fewer pieces than the one before costs allocations on the next longer line.
+     *
+     * Pass a std::vector<std::string_view> instead to get views into str with no string copies at
+     * all (str must then outlive the views).
+     *
+     * Example:
+     *
+     * std::vector<std::string> fields;
+     * while(std::getline(file, line))
+     * {
+     *     separateInto(line, ',', fields);
+     *     //...use fields...
+     * }
+     *
+     * @param str - The std::string we intend to separate with this function.
+     * @param separator - The char we intend to separate str by.
+     * @param out - A std::vector<std::string> or std::vector<std::string_view> the pieces are written into.
+     * @param omitEmptyStrings - If true, do not include empty strings in out.
+     *
+     * @retval None, but operates by reference to fill out with the pieces of str.
+     */
+    template<typename Container>
+    inline void separateInto(   const std::string_view & str,
+                                const char separator,
+                                Container & out,
+                                const bool omitEmptyStrings = true  )
+    {
+        size_t pieceCount = 0;
+        //Same as separate() - an empty string has no pieces
+        if(!str.empty())
+        {
+            detail::forEachSeparatedPiece(str, separator, omitEmptyStrings, [&](const std::string_view & piece)
+            {
+                detail::storePiece(out, pieceCount++, piece);
+            });
+        }
+        out.erase(out.begin() + pieceCount, out.end());
+    }
+
+
+    /**
+     * Variant of separateInto that lets you separate by strings instead of chars - see the char
+     * variant for how out is reused, and separate() for how an empty separator splits into codepoints.
+     *
+     * @param str - The std::string we intend to separate with this function.
+     * @param separator - The substring of str we intend to separate it by.
+     * @param out - A std::vector<std::string> or std::vector<std::string_view> the pieces are written into.
+     * @param omitEmptyStrings - If true, do not include empty strings in out.
+     *
+     * @retval None, but operates by reference to fill out with the pieces of str.
+     */
+    template<typename Container>
+    inline void separateInto(   const std::string_view & str,
+                                const std::string_view & separator,
+                                Container & out,
+                                const bool omitEmptyStrings = true  )
+    {
+        size_t pieceCount = 0;
+        //A one-char separator follows separate(str, char) - no pieces for an empty string
+        if(!(str.empty() && separator.length() == 1))
+        {
+            detail::forEachSeparatedPiece(str, separator, omitEmptyStrings, [&](const std::string_view & piece)
+            {
+                detail::storePiece(out, pieceCount++, piece);
+            });
+        }
+        out.erase(out.begin() + pieceCount, out.end());
+    }
+
+
+    /**
+     * Variant of separateInto that splits on any char of a CharSet of delimiters - see the char
+     * variant for how out is reused.
+     *
+     * @param str - The std::string we intend to separate with this function.
+     * @param separators - The set of chars, any one of which separates str.
+     * @param out - A std::vector<std::string> or std::vector<std::string_view> the pieces are written into.
+     * @param omitEmptyStrings - If true, do not include empty strings in out.
+     *
+     * @retval None, but operates by reference to fill out with the pieces of str.
+     */
+    template<typename Container>
+    inline void separateInto(   const std::string_view & str,
+                                const CharSet & separators,
+                                Container & out,
+                                const bool omitEmptyStrings = true  )
+    {
+        size_t pieceCount = 0;
+        if(!str.empty())
+        {
+            const detail::CharSetTables & tables = separators.tables();
+            detail::forEachSeparatedPiece(str, tables, omitEmptyStrings, [&](const std::string_view & piece)
+            {
+                detail::storePiece(out, pieceCount++, piece);
+            });
+        }
+        out.erase(out.begin() + pieceCount, out.end());
+    }
+
+
+    /**
+     * A compact, owning table of string tokens: every token's chars are stored back to back in one
+     * contiguous buffer, and a packed array of offsets records where each token ends. Fill one with
+     * separateInto() as an alternative to the std::vector<std::string> separate() returns.
+     *
+     * A std::vector<std::string> spends a whole std::string object (32 bytes on common 64-bit
+     * standard libraries) per token even when the token is a couple of chars long, and every token
+     * too long for the small string buffer lives in its own separate heap block. A TokenTable spends
+     * one offset (sizeof(size_t)) per token on top of the chars themselves, in two allocations total,
+     * and scanning its tokens walks memory in order. Reusing the same TokenTable across calls reuses
+     * both allocations.
+     *
+     * Tokens are read back as std::string_view (by index or by iterating), valid until the table is
+     * next modified. Convert to a std::vector<std::string> with toVector() (or implicitly) wherever
+     * the old type is needed.
+    */
+    class TokenTable
+    {
+    public:
+        //An input iterator: tokens are handed out by value as views, so there's no std::string_view
+        //stored in the table for a forward iterator's reference to refer to
+        class iterator
+        {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = std::string_view;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = std::string_view;
+
+            iterator() = default;
+
+            std::string_view operator*() const { return (*m_table)[m_index]; }
+
+            iterator & operator++()
+            {
+                m_index++;
+                return *this;
+            }
+
+            iterator operator++(int)
+            {
+                iterator previous = *this;
+                m_index++;
+                return previous;
+            }
+
+            friend bool operator==(const iterator & lhs, const iterator & rhs) { return lhs.m_index == rhs.m_index; }
+            friend bool operator!=(const iterator & lhs, const iterator & rhs) { return lhs.m_index != rhs.m_index; }
+
+        private:
+            friend class TokenTable;
+
+            iterator(const TokenTable * table, size_t index) : m_table(table), m_index(index) {}
+
+            const TokenTable * m_table = nullptr;
+            size_t m_index = 0;
+        };
+
+        TokenTable() = default;
+
+        /**
+         * @retval size_t - The number of tokens in the table.
+        */
+        size_t size() const { return m_ends.size(); }
+
+        /**
+         * @retval bool - True if the table holds no tokens.
+        */
+        bool empty() const { return m_ends.empty(); }
+
+        /**
+         * @param index - The index of the token to get. Must be less than size().
+         *
+         * @retval std::string_view - The token at index, viewing the table's own buffer.
+        */
+        std::string_view operator[](size_t index) const
+        {
+            size_t start = (index == 0) ? 0 : m_ends[index - 1];
+            return std::string_view(m_chars.data() + start, m_ends[index] - start);
+        }
+
+        iterator begin() const { return iterator(this, 0); }
+        iterator end() const { return iterator(this, m_ends.size()); }
+
+        /**
+         * Append a copy of token to the end of the table.
+        */
+        void push_back(const std::string_view & token)
+        {
+            m_chars.append(token.data(), token.size());
+            m_ends.push_back(m_chars.size());
+        }
+
+        /**
+         * Remove every token, keeping the allocated capacity for reuse.
+        */
+        void clear()
+        {
+            m_chars.clear();
+            m_ends.clear();
+        }
+
+        /**
+         * Reserve room for tokenCount tokens totalling charCount chars.
+        */
+        void reserve(size_t tokenCount, size_t charCount)
+        {
+            m_ends.reserve(tokenCount);
+            m_chars.reserve(charCount);
+        }
+
+        /**
+         * @retval std::vector<std::string> - Every token copied into its own std::string, in order.
+        */
+        std::vector<std::string> toVector() const
+        {
+            std::vector<std::string> tokens;
+            tokens.reserve(size());
+            for(const std::string_view token : *this)
+            {
+                tokens.emplace_back(token);
+            }
+            return tokens;
+        }
+
+        operator std::vector<std::string>() const
+        {
+            return toVector();
+        }
+
+    private:
+        std::string m_chars;        // every token's chars, back to back
+        std::vector<size_t> m_ends; // m_ends[i] is the offset in m_chars just past token i
+    };
+
+
+    /**
+     * Variant of separateInto that fills a TokenTable - see TokenTable for why that's cheaper than a
+     * std::vector<std::string> for many small tokens. out is cleared first and keeps its capacity,
+     * so reusing one table across calls stops allocating once it has grown to fit.
+     *
+     * @param str - The std::string we intend to separate with this function.
+     * @param separator - The char we intend to separate str by.
+     * @param out - The TokenTable the pieces are written into.
+     * @param omitEmptyStrings - If true, do not include empty strings in out.
+     *
+     * @retval None, but operates by reference to fill out with the pieces of str.
+     */
+    inline void separateInto(   const std::string_view & str,
+                                const char separator,
+                                TokenTable & out,
+                                const bool omitEmptyStrings = true  )
+    {
+        out.clear();
+        if(str.empty())
+        {
+            return;
+        }
+        //Pieces never total more chars than str itself, so one reserve covers the char buffer
+        out.reserve(detail::countChar(str, separator) + 1, str.length());
+        detail::forEachSeparatedPiece(str, separator, omitEmptyStrings, [&](const std::string_view & piece)
+        {
+            out.push_back(piece);
+        });
+    }
+
+
+    /**
+     * Variant of separateInto that fills a TokenTable, separating by strings instead of chars.
+     *
+     * @param str - The std::string we intend to separate with this function.
+     * @param separator - The substring of str we intend to separate it by.
+     * @param out - The TokenTable the pieces are written into.
+     * @param omitEmptyStrings - If true, do not include empty strings in out.
+     *
+     * @retval None, but operates by reference to fill out with the pieces of str.
+     */
+    inline void separateInto(   const std::string_view & str,
+                                const std::string_view & separator,
+                                TokenTable & out,
+                                const bool omitEmptyStrings = true  )
+    {
+        out.clear();
+        if(str.empty() && separator.length() == 1)
+        {
+            return;
+        }
+        out.reserve(0, str.length());
+        detail::forEachSeparatedPiece(str, separator, omitEmptyStrings, [&](const std::string_view & piece)
+        {
+            out.push_back(piece);
+        });
+    }
+
+
+    /**
+     * Variant of separateInto that fills a TokenTable, splitting on any char of a CharSet.
+     *
+     * @param str - The std::string we intend to separate with this function.
+     * @param separators - The set of chars, any one of which separates str.
+     * @param out - The TokenTable the pieces are written into.
+     * @param omitEmptyStrings - If true, do not include empty strings in out.
+     *
+     * @retval None, but operates by reference to fill out with the pieces of str.
+     */
+    inline void separateInto(   const std::string_view & str,
+                                const CharSet & separators,
+                                TokenTable & out,
+                                const bool omitEmptyStrings = true  )
+    {
+        out.clear();
+        if(str.empty())
+        {
+            return;
+        }
+        out.reserve(0, str.length());
+        detail::forEachSeparatedPiece(str, separators.tables(), omitEmptyStrings, [&](const std::string_view & piece)
+        {
+            out.push_back(piece);
+        });
+    }
+
+
+    /**
+     * A lazy, non-owning range over the pieces of a std::string_view separated by a separator char
+     * or substring. Returned by splitView() - see that function's doc comment for the public API.
+     *
+     * Each piece is produced on demand as the range is iterated, as a std::string_view pointing
+     * straight into the source string - no std::string is ever allocated, and nothing past the
+     * current piece is scanned until the iterator is advanced. Because of that, the source string
+     * must outlive both the SplitView and every piece taken from it.
+    */
+    class SplitView
+    {
+    public:
+        class iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::string_view;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const std::string_view *;
+            using reference = const std::string_view &;
+
+            iterator() = default;
+
+            reference operator*() const { return m_piece; }
+            pointer operator->() const { return &m_piece; }
+
+            iterator & operator++()
+            {
+                advance();
+                return *this;
+            }
+
+            iterator operator++(int)
+            {
+                iterator previous = *this;
+                advance();
+                return previous;
+            }
+
+            friend bool operator==(const iterator & lhs, const iterator & rhs)
+            {
+                if(lhs.m_atEnd || rhs.m_atEnd)
+                {
+                    return lhs.m_atEnd == rhs.m_atEnd;
+                }
+                return lhs.m_piece.data() == rhs.m_piece.data() && lhs.m_next == rhs.m_next;
+            }
+
+            friend bool operator!=(const iterator & lhs, const iterator & rhs)
+            {
+                return !(lhs == rhs);
+            }
+
+        private:
+            friend class SplitView;
+
+            //Begin iterator - finds the first piece straight away
+            explicit iterator(const SplitView * view) : m_view(view), m_atEnd(false)
+            {
+                advance();
+            }
+
+            void advance()
+            {
+                const std::string_view & str = m_view->m_str;
+                while(true)
+                {
+                    //m_next == npos means the final piece has already been handed out
+                    if(m_next == std::string_view::npos)
+                    {
+                        m_atEnd = true;
+                        return;
+                    }
+
+                    //Empty separator - every piece is one whole codepoint (see separate())
+                    if(m_view->m_separator.empty())
+                    {
+                        if(m_next == str.length())
+                        {
+                            m_atEnd = true;
+                            return;
+                        }
+                        size_t after = m_next + 1;
+                        if(static_cast<unsigned char>(str[m_next]) >= 0x80)
+                        {
+                            auto it = str.begin() + m_next;
+                            utf8::next(it, str.end()); // advances it past one codepoint
+                            after = static_cast<size_t>(it - str.begin());
+                        }
+                        m_piece = str.substr(m_next, after - m_next);
+                        m_next = after;
+                        return;
+                    }
+
+                    size_t separatorIndex = (m_view->m_separator.length() == 1)
+                                            ? str.find(m_view->m_separator[0], m_next)
+                                            : str.find(m_view->m_separator, m_next);
+                    if(separatorIndex == std::string_view::npos)
+                    {
+                        m_piece = str.substr(m_next);
+                        m_next = std::string_view::npos;
+                    }
+                    else
+                    {
+                        m_piece = str.substr(m_next, separatorIndex - m_next);
+                        m_next = separatorIndex + m_view->m_separator.length();
+                    }
+
+                    if(!m_piece.empty() || !m_view->m_omitEmptyStrings)
+                    {
+                        return;
+                    }
+                }
+            }
+
+            const SplitView * m_view = nullptr;
+            std::string_view m_piece;
+            size_t m_next = 0;     // byte offset where the search for the next piece starts
+            bool m_atEnd = true;
+        };
+
+        SplitView(  const std::string_view & str,
+                    const char separator,
+                    const bool omitEmptyStrings   )
+            : m_str(str), m_separatorChar(separator), m_omitEmptyStrings(omitEmptyStrings)
+        {
+            m_separator = std::string_view(&m_separatorChar, 1);
+            //Same as separate(str, char): an empty string has no pieces, not even one empty piece
+            m_hasPieces = !str.empty();
+        }
+
+        SplitView(  const std::string_view & str,
+                    const std::string_view & separator,
+                    const bool omitEmptyStrings   )
+            : m_str(str), m_separator(separator), m_omitEmptyStrings(omitEmptyStrings)
+        {
+            //Same as separate(str, string): a one-char separator takes the char path, and an
+            //empty string only yields (a single empty piece) when empty pieces are being kept
+            if(separator.length() == 1)
+            {
+                m_separatorChar = separator[0];
+                m_separator = std::string_view(&m_separatorChar, 1);
+                m_hasPieces = !str.empty();
+            }
+            else
+            {
+                m_hasPieces = !str.empty() || (!omitEmptyStrings && !separator.empty());
+            }
+        }
+
+        //m_separator may point at m_separatorChar, so copies have to re-point it at their own copy
+        SplitView(const SplitView & other) { *this = other; }
+
+        SplitView & operator=(const SplitView & other)
+        {
+            m_str = other.m_str;
+            m_separatorChar = other.m_separatorChar;
+            m_separator = (other.m_separator.data() == &other.m_separatorChar)
+                          ? std::string_view(&m_separatorChar, 1)
+                          : other.m_separator;
+            m_omitEmptyStrings = other.m_omitEmptyStrings;
+            m_hasPieces = other.m_hasPieces;
+            return *this;
+        }
+
+        iterator begin() const { return m_hasPieces ? iterator(this) : iterator(); }
+        iterator end() const { return iterator(); }
+
+        /**
+         * Copy every piece into a std::vector<std::string> - the same result separate() returns.
+        */
+        std::vector<std::string> toVector() const
+        {
+            std::vector<std::string> pieces;
+            for(const std::string_view & piece : *this)
+            {
+                pieces.emplace_back(piece);
+            }
+            return pieces;
+        }
+
+    private:
+        std::string_view m_str;
+        std::string_view m_separator;
+        char m_separatorChar = '\0';
+        bool m_omitEmptyStrings = true;
+        bool m_hasPieces = false;
+    };
+
+
+    /**
+     * Lazy, zero-copy variant of separate() for when you only need to walk the separated pieces
+     * once (e.g. tokenizing log lines). Returns a SplitView whose iterators yield std::string_view
+     * pieces pointing into str, instead of materializing a std::vector<std::string> with one
+     * heap-allocated std::string per piece.
+     *
+     * Yields exactly the same pieces, in the same order, as separate(str, separator, omitEmptyStrings).
+     *
+     * Example:
+     *
+     * for(std::string_view field : splitView("John,Gina,Sebastian,Nick", ','))
+     * {
+     *     //field is "John", then "Gina", then "Sebastian", then "Nick"
+     * }
+     *
+     * @param str - The std::string we intend to separate. Must outlive the returned SplitView.
+     * @param separator - The char we intend to separate str by.
+     * @param omitEmptyStrings - If true, skip empty pieces.
+     *
+     * @retval SplitView - A lazy range of std::string_view pieces of str.
+    */
+    inline SplitView splitView( const std::string_view & str,
+                                const char separator = ',',
+                                const bool omitEmptyStrings = true  )
+    {
+        return SplitView(str, separator, omitEmptyStrings);
+    }
+
+
+    /**
+     * Variant of splitView that lets you separate by strings instead of chars. Like separate(), an
+     * empty separator splits str into individual codepoints (each piece a whole, possibly
+     * multi-byte, UTF-8 character).
+     *
+     * @param str - The std::string we intend to separate. Must outlive the returned SplitView.
+     * @param separator - The substring we intend to separate str by. Must also outlive the returned SplitView.
+     * @param omitEmptyStrings - If true, skip empty pieces.
+     *
+     * @retval SplitView - A lazy range of std::string_view pieces of str.
+    */
+    inline SplitView splitView( const std::string_view & str,
+                                const std::string_view & separator,
+                                const bool omitEmptyStrings = true  )
+    {
+        return SplitView(str, separator, omitEmptyStrings);
+    }
+
+
+    /**
+     * One field of a CSV record, as handed out by forEachCsvRecord(). raw views the field's text in
+     * the original CSV - for a quoted field, the text between the enclosing quotes, with any
+     * escaped quotes ("") still doubled. unescaped() gives the field's actual value.
+     *
+     * A quoted field is malformed if text follows its closing quote before the next delimiter
+     * (e.g. "a"b), or if its quote is never closed. Nothing is dropped from a malformed field: raw
+     * is everything after the opening quote, and unescaped() leaves out the stray closing quote,
+     * so "a"b reads as ab - the usual lenient reading. An unclosed quote runs to the end of the
+     * CSV, newlines and delimiters included.
+    */
+    struct CsvField
+    {
+        std::string_view raw;
+        bool quoted = false;
+        bool malformed = false;
+
+        /**
+         * The value of this field, with escaped quotes ("") collapsed into single quotes (and, in
+         * a malformed field, the stray closing quote left out).
+         *
+         * @retval std::string - The field's value.
+        */
+        std::string unescaped() const
+        {
+            if(!quoted)
+            {
+                return std::string(raw);
+            }
+            std::string value;
+            value.reserve(raw.length());
+            size_t start = 0;
+            size_t quote;
+            while((quote = raw.find('"', start)) != std::string_view::npos)
+            {
+                //Keep one quote of each "" pair, and drop a lone quote (a malformed field's closing quote)
+                value.append(raw.substr(start, quote - start));
+                start = quote + 1;
+                if(start < raw.length() && raw[start] == '"')
+                {
+                    value += '"';
+                    start++;
+                }
+            }
+            value.append(raw.substr(start));
+            return value;
+        }
+    };
+
+
+    /**
+     * Parses csv as RFC 4180 CSV and calls visitor(record) for every record in it, where record is
+     * a const std::vector<CsvField>& of the record's fields. Fields view csv directly - nothing is
+     * copied - and the vector is reused between records, so copy out anything you want to keep.
+     *
+     * Quoted fields may contain delimiters, escaped quotes ("") and newlines, so one record can
+     * span several lines. Records end at "\n" or "\r\n", and blank lines are skipped. Malformed
+     * quoted fields are read leniently and flagged - see CsvField. Unlike
+     * separate(csv, ','), the scan finds delimiters and newlines outside quotes 64 bytes at a
+     * time, using SIMD compares and a prefix XOR over the block's quote mask.
+     *
+     * Example:
+     *
+     * forEachCsvRecord("name,quote\nJohn,\"Hi, \"\"Gina\"\"\"\n", [](const std::vector<CsvField> & record)
+     * {
+     *     //First {"name", "quote"}, then {"John", "Hi, \"Gina\""} (via unescaped())
+     * });
+     *
+     * @param csv - The CSV text to parse. Must outlive any views taken of its fields.
+     * @param visitor - Callable taking a const std::vector<CsvField>&, called once per record.
+     * @param delimiter - The char separating fields within a record.
+    */
+    template<typename Visitor>
+    inline void forEachCsvRecord(   const std::string_view & csv,
+                                    Visitor && visitor,
+                                    const char delimiter = ','  )
+    {
+        std::vector<CsvField> record;
+        record.reserve(16);
+        size_t fieldStart = 0;
+
+        auto endField = [&](size_t fieldEnd, bool endsRecord)
+        {
+            std::string_view text = csv.substr(fieldStart, fieldEnd - fieldStart);
+            if(endsRecord && !text.empty() && text.back() == '\r')
+            {
+                text.remove_suffix(1);
+            }
+            CsvField field;
+            field.raw = text;
+            if(!text.empty() && text.front() == '"')
+            {
+                //Find the closing quote, stepping over escaped ("") ones
+                size_t closingQuote = text.find('"', 1);
+                while(closingQuote != std::string_view::npos && closingQuote + 1 < text.length() && text[closingQuote + 1] == '"')
+                {
+                    closingQuote = text.find('"', closingQuote + 2);
+                }
+                field.quoted = true;
+                if(closingQuote == text.length() - 1)
+                {
+                    field.raw = text.substr(1, closingQuote - 1);
+                }
+                else
+                {
+                    //Text after the closing quote, or no closing quote at all - keep all of it
+                    field.raw = text.substr(1);
+                    field.malformed = true;
+                }
+            }
+            record.push_back(field);
+        };
+        auto endRecord = [&]()
+        {
+            bool blankLine = (record.size() == 1) && !record[0].quoted && record[0].raw.empty();
+            if(!blankLine)
+            {
+                visitor(static_cast<const std::vector<CsvField> &>(record));
+            }
+            record.clear();
+        };
+
+        detail::forEachCsvStructuralPosition(csv, delimiter, [&](size_t index)
+        {
+            bool newline = (csv[index] == '\n');
+            endField(index, newline);
+            fieldStart = index + 1;
+            if(newline)
+            {
+                endRecord();
+            }
+            return true;
+        });
+
+        //The last record may not end with a newline
+        if(fieldStart < csv.length() || !record.empty())
+        {
+            endField(csv.length(), true);
+            endRecord();
+        }
+    }
+
+
+    /**
+     * Parses csv as RFC 4180 CSV into a vector of records, each a vector of its unescaped field
+     * values. See forEachCsvRecord() for the parsing rules, and to parse without copying.
+     *
+     * Example:
+     *
+     * parseCsv("a,\"b,c\"\n1,2\n") == {{"a", "b,c"}, {"1", "2"}}
+     *
+     * @param csv - The CSV text to parse.
+     * @param delimiter - The char separating fields within a record.
+     *
+     * @retval std::vector<std::vector<std::string>> - The records of csv, in order.
+    */
+    inline std::vector<std::vector<std::string>> parseCsv(  const std::string_view & csv,
+                                                            const char delimiter = ','  )
+    {
+        std::vector<std::vector<std::string>> records;
+        forEachCsvRecord(csv, [&](const std::vector<CsvField> & record)
+        {
+            std::vector<std::string> values;
+            values.reserve(record.size());
+            for(const CsvField & field : record)
+            {
+                values.push_back(field.unescaped());
+            }
+            records.push_back(std::move(values));
+        }, delimiter);
+        return records;
+    }
+
+
+    /**
+     * Streaming variant of separate, for inputs too big to hold in memory: reads input through
+     * one reusable buffer of bufferSize bytes and calls visitor(token) for every token as soon as
+     * it has been read in full, with token a std::string_view into that buffer - only valid
+     * during the call, so copy it out to keep it. Tokens split across two reads are stitched
+     * together before being handed out, and for non-empty input the visited tokens are exactly
+     * those separate(wholeInput, separator, omitEmptyStrings) would return. Memory use stays at
+     * bufferSize unless a single token is longer, in which case the buffer grows to fit it.
+     *
+     * Example:
+     *
+     * std::ifstream file("export.log");
+     * forEachToken(file, '\n', [&](std::string_view line)
+     * {
+     *     //One line at a time, no matter how big export.log is
+     * });
+     *
+     * @param input - The stream to read tokens from, read until its end.
+     * @param separator - The char separating tokens.
+     * @param visitor - Callable taking a std::string_view token.
+     * @param omitEmptyStrings - If true, empty tokens are skipped.
+     * @param bufferSize - The size in bytes of the read buffer.
+    */
+    template<typename Visitor>
+    inline void forEachToken(   std::istream & input,
+                                const char separator,
+                                Visitor && visitor,
+                                const bool omitEmptyStrings = true,
+                                const size_t bufferSize = size_t(1) << 16   )
+    {
+        detail::forEachStreamedPiece(input, separator, omitEmptyStrings, bufferSize, visitor);
+    }
+
+
+    /**
+     * Variant of the streaming forEachToken that separates by strings instead of chars.
+     *
+     * @param input - The stream to read tokens from, read until its end.
+     * @param separator - The substring separating tokens. Can't be empty.
+     * @param visitor - Callable taking a std::string_view token.
+     * @param omitEmptyStrings - If true, empty tokens are skipped.
+     * @param bufferSize - The size in bytes of the read buffer.
+    */
+    template<typename Visitor>
+    inline void forEachToken(   std::istream & input,
+                                const std::string_view & separator,
+                                Visitor && visitor,
+                                const bool omitEmptyStrings = true,
+                                const size_t bufferSize = size_t(1) << 16   )
+    {
+        if(separator.empty())
+        {
+            throw std::invalid_argument("separator cannot be empty for forEachToken()");
+        }
+        detail::forEachStreamedPiece(input, separator, omitEmptyStrings, bufferSize, visitor);
+    }
+
+
+#if defined(STEVENSSTRINGLIB_POSIX_IO)
+    /**
+     * Variant of the streaming forEachToken that reads from a POSIX file descriptor (a file,
+     * pipe or socket) with read(), bypassing iostreams entirely. Reads until read() reports the
+     * end of the input; throws std::system_error if it fails.
      *
-     * @retval std::vector<std::string> - A vector of substrings of the original string that have been split up by all occurrences of the separator parameter
+     * @param fileDescriptor - The open file descriptor to read tokens from. Not closed afterwards.
+     * @param separator - The char separating tokens.
+     * @param visitor - Callable taking a std::string_view token.
+     * @param omitEmptyStrings - If true, empty tokens are skipped.
+     * @param bufferSize - The size in bytes of the read buffer.
+    */
+    template<typename Visitor>
+    inline void forEachToken(   const int fileDescriptor,
+                                const char separator,
+                                Visitor && visitor,
+                                const bool omitEmptyStrings = true,
+                                const size_t bufferSize = size_t(1) << 16   )
+    {
+        detail::forEachStreamedPiece(fileDescriptor, separator, omitEmptyStrings, bufferSize, visitor);
+    }
+
+
+    /**
+     * Variant of the file descriptor forEachToken that separates by strings instead of chars.
+     *
+     * @param fileDescriptor - The open file descriptor to read tokens from. Not closed afterwards.
+     * @param separator - The substring separating tokens. Can't be empty.
+     * @param visitor - Callable taking a std::string_view token.
+     * @param omitEmptyStrings - If true, empty tokens are skipped.
+     * @param bufferSize - The size in bytes of the read buffer.
+    */
+    template<typename Visitor>
+    inline void forEachToken(   const int fileDescriptor,
+                                const std::string_view & separator,
+                                Visitor && visitor,
+                                const bool omitEmptyStrings = true,
+                                const size_t bufferSize = size_t(1) << 16   )
+    {
+        if(separator.empty())
+        {
+            throw std::invalid_argument("separator cannot be empty for forEachToken()");
+        }
+        detail::forEachStreamedPiece(fileDescriptor, separator, omitEmptyStrings, bufferSize, visitor);
+    }
+#endif
+
+
+    /**
+     * Variant of join that concatenates the elements of [first, last). The iterators must be
+     * forward iterators (or better), as the elements are visited twice.
+     *
+     * @param first The iterator to the first element to concatenate
+     * @param last The iterator one past the last element to concatenate
+     * @param separator The characters that will be placed between all concatenated elements
+     * @param omitEmptyStrings If true, empty elements are left out, along with their separators
+     *
+     * @returns A std::string of all of the elements concatenated with the separator between each element.
      */
-    inline std::vector<std::string> separate(   const std::string_view & str,
-                                                const char separator = ',',
-                                                const bool omitEmptyStrings = true  )
+    template<typename Iterator>
+    inline std::string join(    Iterator first,
+                                Iterator last,
+                                const std::string_view & separator,
+                                const bool omitEmptyStrings = true  )
+    {
+        std::string str(detail::joinedLength(first, last, separator.length(), omitEmptyStrings), '\0');
+        detail::writeJoined(str.data(), first, last, separator, omitEmptyStrings);
+        return str;
+    }
+
+
+    /**
+     * @brief Given a range of strings, concatenate them all into a single string, separating each element
+     * in the final returned std::string by a given separator string.
+     *
+     * Essentially, reverses the operation of the separate function.
+     *
+     * The exact length of the result is computed in a first pass over the elements, so it's
+     * allocated once and then filled with plain copies.
+     *
+     * Example:
+     *
+     * std::vector<std::string_view> fields = {"John", "Doe", "NY"};
+     * std::string row = join(fields, ",");
+     *
+     * //Value of row is: "John,Doe,NY"
+     *
+     * @param range Any range (e.g. a std::vector or an array) of std::strings, std::string_views,
+     *              const char *s or other types convertible to std::string_view.
+     * @param separator The characters that will be placed between all concatenated elements
+     * @param omitEmptyStrings If true, empty elements are left out, along with their separators
+     *
+     * @returns A std::string of all of the elements in the range concatenated with the separator between each element.
+     */
+    template<typename Range>
+    inline std::string join(    const Range & range,
+                                const std::string_view & separator,
+                                const bool omitEmptyStrings = true  )
+    {
+        using std::begin;
+        using std::end;
+        return join(begin(range), end(range), separator, omitEmptyStrings);
+    }
+
+
+    /**
+     * Variant of join for a braced list of elements, e.g. join({first, middle, last}, " ").
+     *
+     * @param pieces The elements to concatenate
+     * @param separator The characters that will be placed between all concatenated elements
+     * @param omitEmptyStrings If true, empty elements are left out, along with their separators
+     *
+     * @returns A std::string of all of the elements concatenated with the separator between each element.
+     */
+    inline std::string join(    std::initializer_list<std::string_view> pieces,
+                                const std::string_view & separator,
+                                const bool omitEmptyStrings = true  )
+    {
+        return join(pieces.begin(), pieces.end(), separator, omitEmptyStrings);
+    }
+
+
+    /**
+     * Parallel variant of join, for joining very large ranges (e.g. tens of millions of tokens back
+     * into a CSV body) on several cores. The range is cut into even runs of elements; worker
+     * threads first total up each run's output length, a prefix sum over those totals gives each
+     * run its offset into the result, and the threads then copy their runs into their own
+     * disjoint slices of it. The result is always identical to join(range, separator, omitEmptyStrings).
+     *
+     * Each element is counted as at least sizeof(std::string_view) bytes of work when deciding
+     * whether splitting is worthwhile (see ParallelSettings); ranges too small for two chunks, and
+     * ranges without random access iterators, are joined serially.
+     *
+     * @param range Any random access range (e.g. a std::vector) of std::strings, std::string_views,
+     *              const char *s or other types convertible to std::string_view.
+     * @param separator The characters that will be placed between all concatenated elements
+     * @param omitEmptyStrings If true, empty elements are left out, along with their separators
+     * @param parallelSettings How many threads to use, and the smallest chunk worth a thread.
+     *
+     * @returns A std::string of all of the elements concatenated with the separator between each element.
+     */
+    template<typename Range>
+    inline std::string join(    const Range & range,
+                                const std::string_view & separator,
+                                const bool omitEmptyStrings,
+                                const ParallelSettings & parallelSettings  )
+    {
+        using std::begin;
+        using std::end;
+        using Iterator = decltype(begin(range));
+        if constexpr(!std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category>)
+        {
+            return join(range, separator, omitEmptyStrings);
+        }
+        else
+        {
+            const Iterator first = begin(range);
+            const size_t elementCount = static_cast<size_t>(end(range) - first);
+            const size_t chunkCount = detail::parallelChunkCount(   elementCount * sizeof(std::string_view),
+                                                                    parallelSettings.threadCount,
+                                                                    parallelSettings.minChunkSize );
+            if(chunkCount <= 1)
+            {
+                return join(range, separator, omitEmptyStrings);
+            }
+            auto chunkBegin = [&](size_t chunk)
+            {
+                return first + static_cast<std::ptrdiff_t>(elementCount * chunk / chunkCount);
+            };
+
+            //Count each chunk's pieces and their bytes, not yet knowing which chunks need a leading separator
+            std::vector<size_t> pieceCounts(chunkCount), pieceBytes(chunkCount);
+            detail::runInParallel(chunkCount, [&](size_t chunk)
+            {
+                for(Iterator element = chunkBegin(chunk), chunkEnd = chunkBegin(chunk + 1); element != chunkEnd; ++element)
+                {
+                    const size_t pieceLength = std::string_view(*element).length();
+                    if(pieceLength == 0 && omitEmptyStrings)
+                    {
+                        continue;
+                    }
+                    pieceBytes[chunk] += pieceLength;
+                    pieceCounts[chunk]++;
+                }
+            });
+
+            //Prefix sum: a chunk's pieces are each preceded by a separator, except the very first piece of the whole result
+            std::vector<size_t> offsets(chunkCount + 1, 0);
+            std::vector<bool> leadingSeparator(chunkCount, false);
+            bool anyPieceBefore = false;
+            for(size_t chunk = 0; chunk < chunkCount; chunk++)
+            {
+                size_t chunkLength = pieceBytes[chunk];
+                if(pieceCounts[chunk] > 0)
+                {
+                    leadingSeparator[chunk] = anyPieceBefore;
+                    chunkLength += (pieceCounts[chunk] - (anyPieceBefore ? 0 : 1)) * separator.length();
+                    anyPieceBefore = true;
+                }
+                offsets[chunk + 1] = offsets[chunk] + chunkLength;
+            }
+
+            std::string str(offsets[chunkCount], '\0');
+            detail::runInParallel(chunkCount, [&](size_t chunk)
+            {
+                char * out = str.data() + offsets[chunk];
+                if(leadingSeparator[chunk])
+                {
+                    out = std::copy(separator.begin(), separator.end(), out);
+                }
+                detail::writeJoined(out, chunkBegin(chunk), chunkBegin(chunk + 1), separator, omitEmptyStrings);
+            });
+            return str;
+        }
+    }
+
+
+    /**
+     * @param range - Any range of std::strings, std::string_views, const char *s or other types
+     *                convertible to std::string_view.
+     * @param separator - The characters that join() would place between the elements.
+     * @param omitEmptyStrings - If true, empty elements are left out, along with their separators.
+     *
+     * @retval size_t - The length of join(range, separator, omitEmptyStrings), without building it -
+     *         e.g. to size a buffer for joinInto().
+     */
+    template<typename Range>
+    inline size_t joinedLength( const Range & range,
+                                const std::string_view & separator,
+                                const bool omitEmptyStrings = true  )
+    {
+        using std::begin;
+        using std::end;
+        return detail::joinedLength(begin(range), end(range), separator.length(), omitEmptyStrings);
+    }
+
+
+    /**
+     * Variant of join that appends the result to an existing string instead of returning a new
+     * one, so a single buffer can be reused across many calls (e.g. when building up a large
+     * response body). out grows at most once per call.
+     *
+     * Example:
+     *
+     * std::string body = "fields=";
+     * joinInto(fields, ",", body);
+     *
+     * @param range - Any range of std::strings, std::string_views, const char *s or other types
+     *                convertible to std::string_view.
+     * @param separator - The characters that will be placed between all concatenated elements.
+     * @param out - The string the joined elements are appended to.
+     * @param omitEmptyStrings - If true, empty elements are left out, along with their separators.
+     *
+     * @retval None, but operates by reference to append to out.
+     */
+    template<typename Range>
+    inline void joinInto(   const Range & range,
+                            const std::string_view & separator,
+                            std::string & out,
+                            const bool omitEmptyStrings = true  )
+    {
+        using std::begin;
+        using std::end;
+        const size_t oldLength = out.length();
+        out.resize(oldLength + detail::joinedLength(begin(range), end(range), separator.length(), omitEmptyStrings));
+        detail::writeJoined(out.data() + oldLength, begin(range), end(range), separator, omitEmptyStrings);
+    }
+
+
+    /**
+     * Variant of joinInto that writes into the fixed buffer [first, last), reporting overflow the
+     * way std::to_chars() does. Nothing is written if the result doesn't fit; use joinedLength()
+     * to find the size needed. No null terminator is written.
+     *
+     * @param range - Any range of std::strings, std::string_views, const char *s or other types
+     *                convertible to std::string_view.
+     * @param separator - The characters that will be placed between all concatenated elements.
+     * @param first - The start of the buffer to write into.
+     * @param last - One past the end of the buffer to write into.
+     * @param omitEmptyStrings - If true, empty elements are left out, along with their separators.
+     *
+     * @retval std::to_chars_result - On success, {one past the last char written, std::errc()}.
+     *         If the buffer is too small, {last, std::errc::value_too_large}.
+     */
+    template<typename Range>
+    inline std::to_chars_result joinInto(   const Range & range,
+                                            const std::string_view & separator,
+                                            char * first,
+                                            char * last,
+                                            const bool omitEmptyStrings = true  )
+    {
+        using std::begin;
+        using std::end;
+        if(detail::joinedLength(begin(range), end(range), separator.length(), omitEmptyStrings) > static_cast<size_t>(last - first))
+        {
+            return {last, std::errc::value_too_large};
+        }
+        return {detail::writeJoined(first, begin(range), end(range), separator, omitEmptyStrings), std::errc()};
+    }
+
+
+    /**
+     * Variant of joinInto that writes through an output iterator of chars, e.g. a
+     * std::back_inserter or a std::ostreambuf_iterator. The elements are visited only once.
+     *
+     * @param range - Any range of std::strings, std::string_views, const char *s or other types
+     *                convertible to std::string_view.
+     * @param separator - The characters that will be placed between all concatenated elements.
+     * @param out - The output iterator to write the joined elements through.
+     * @param omitEmptyStrings - If true, empty elements are left out, along with their separators.
+     *
+     * @retval OutputIterator - The iterator one past the last char written.
+     */
+    template<typename Range, typename OutputIterator>
+    inline OutputIterator joinInto( const Range & range,
+                                    const std::string_view & separator,
+                                    OutputIterator out,
+                                    const bool omitEmptyStrings = true  )
+    {
+        using std::begin;
+        using std::end;
+        return detail::writeJoined(out, begin(range), end(range), separator, omitEmptyStrings);
+    }
+
+
+    /**
+     * A lazy, non-owning view of what join() would return for a range: a sequence of chunks (the
+     * elements and the separators between them, as std::string_views pointing into the range and
+     * the separator) that's never concatenated into one string. Returned by joinView() - see that
+     * function's doc comment for the public API.
+     *
+     * Iterating it yields the non-empty chunks in order; their concatenation is exactly
+     * join(range, separator, omitEmptyStrings). The range, its elements and the separator must
+     * outlive the view and every chunk taken from it.
+    */
+    template<typename Range>
+    class JoinView
+    {
+        using ElementIterator = decltype(std::begin(std::declval<const Range &>()));
+
+    public:
+        class iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::string_view;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const std::string_view *;
+            using reference = const std::string_view &;
+
+            iterator() = default;
+
+            reference operator*() const { return m_chunk; }
+            pointer operator->() const { return &m_chunk; }
+
+            iterator & operator++()
+            {
+                advance();
+                return *this;
+            }
+
+            iterator operator++(int)
+            {
+                iterator previous = *this;
+                advance();
+                return previous;
+            }
+
+            friend bool operator==(const iterator & lhs, const iterator & rhs)
+            {
+                if(lhs.m_atEnd || rhs.m_atEnd)
+                {
+                    return lhs.m_atEnd == rhs.m_atEnd;
+                }
+                return lhs.m_element == rhs.m_element && lhs.m_elementNext == rhs.m_elementNext;
+            }
+
+            friend bool operator!=(const iterator & lhs, const iterator & rhs)
+            {
+                return !(lhs == rhs);
+            }
+
+        private:
+            friend class JoinView;
+
+            //Begin iterator - finds the first chunk straight away
+            explicit iterator(const JoinView * view)
+                : m_view(view), m_element(std::begin(*view->m_range)), m_end(std::end(*view->m_range)), m_atEnd(false)
+            {
+                advance();
+            }
+
+            void advance()
+            {
+                while(true)
+                {
+                    //A separator was just handed out - the element it goes in front of is next
+                    if(m_elementNext)
+                    {
+                        m_elementNext = false;
+                        m_chunk = std::string_view(*m_element);
+                        ++m_element;
+                        if(!m_chunk.empty())
+                        {
+                            return;
+                        }
+                        continue;
+                    }
+                    if(m_element == m_end)
+                    {
+                        m_atEnd = true;
+                        return;
+                    }
+                    if(m_view->m_omitEmptyStrings && std::string_view(*m_element).empty())
+                    {
+                        ++m_element;
+                        continue;
+                    }
+                    //Every element but the first kept one gets a separator in front of it
+                    m_elementNext = true;
+                    if(m_started && !m_view->m_separator.empty())
+                    {
+                        m_chunk = m_view->m_separator;
+                        return;
+                    }
+                    m_started = true;
+                }
+            }
+
+            const JoinView * m_view = nullptr;
+            ElementIterator m_element{};
+            ElementIterator m_end{};
+            std::string_view m_chunk;
+            bool m_elementNext = false;   // the element at m_element is due, its separator already handed out
+            bool m_started = false;       // an element has been kept already
+            bool m_atEnd = true;
+        };
+
+        JoinView(   const Range & range,
+                    const std::string_view & separator,
+                    const bool omitEmptyStrings   )
+            : m_range(&range), m_separator(separator), m_omitEmptyStrings(omitEmptyStrings),
+              m_size(detail::joinedLength(std::begin(range), std::end(range), separator.length(), omitEmptyStrings))
+        {
+        }
+
+        iterator begin() const { return iterator(this); }
+        iterator end() const { return iterator(); }
+
+        /**
+         * @retval size_t - The total length of the chunks, i.e. of the joined string. Worked out
+         *         once when the view is made.
+        */
+        size_t size() const
+        {
+            return m_size;
+        }
+
+        /**
+         * Concatenate the chunks - the same result join() returns.
+        */
+        std::string str() const
+        {
+            return join(*m_range, m_separator, m_omitEmptyStrings);
+        }
+
+        /**
+         * Write the chunks to an output stream one by one, without concatenating them first.
+         * They go straight to the stream's buffer, under one sentry for the whole view.
+        */
+        friend std::ostream & operator<<(std::ostream & stream, const JoinView & view)
+        {
+            const std::ostream::sentry sentry(stream);
+            if(!sentry)
+            {
+                return stream;
+            }
+            std::streambuf * buffer = stream.rdbuf();
+            for(const std::string_view & chunk : view)
+            {
+                const std::streamsize length = static_cast<std::streamsize>(chunk.length());
+                if(buffer->sputn(chunk.data(), length) != length)
+                {
+                    stream.setstate(std::ios_base::badbit);
+                    break;
+                }
+            }
+            return stream;
+        }
+
+    #if defined(STEVENSSTRINGLIB_POSIX_IO)
+        /**
+         * Point iovecs at the chunks from position on, for scatter-gather output with writev().
+         *
+         * @param position - The first chunk to describe. Advanced past the chunks described.
+         * @param iovecs - The array to fill.
+         * @param maxIovecs - The number of iovecs in the array.
+         *
+         * @retval size_t - The number of iovecs filled; fewer than maxIovecs only once position reaches end().
+        */
+        size_t fillIovecs(  iterator & position,
+                            struct iovec * iovecs,
+                            const size_t maxIovecs  ) const
+        {
+            size_t filled = 0;
+            for(; filled < maxIovecs && position != end(); ++position, filled++)
+            {
+                iovecs[filled].iov_base = const_cast<char *>(position->data());
+                iovecs[filled].iov_len = position->length();
+            }
+            return filled;
+        }
+
+        /**
+         * Write the chunks to a file descriptor (e.g. a socket or a file) with writev(), a batch of
+         * chunks per system call, without concatenating them first. Partial writes are resumed.
+         *
+         * @param fileDescriptor - The open file descriptor to write to. Not closed afterwards.
+         *
+         * @throws std::system_error if writev() fails.
+        */
+        void writeTo(const int fileDescriptor) const
+        {
+        #if defined(IOV_MAX)
+            constexpr size_t batchSize = (IOV_MAX < 64) ? IOV_MAX : 64;
+        #else
+            constexpr size_t batchSize = 16;
+        #endif
+            struct iovec iovecs[batchSize];
+            iterator position = begin();
+            while(true)
+            {
+                size_t count = fillIovecs(position, iovecs, batchSize);
+                if(count == 0)
+                {
+                    return;
+                }
+                struct iovec * pending = iovecs;
+                while(count > 0)
+                {
+                    ssize_t bytesWritten = ::writev(fileDescriptor, pending, static_cast<int>(count));
+                    if(bytesWritten < 0)
+                    {
+                        if(errno == EINTR)
+                        {
+                            continue;
+                        }
+                        throw std::system_error(errno, std::generic_category(), "Error writing to file descriptor");
+                    }
+                    //Skip the iovecs written in full, and trim the one written in part
+                    size_t remaining = static_cast<size_t>(bytesWritten);
+                    while(count > 0 && remaining >= pending->iov_len)
+                    {
+                        remaining -= pending->iov_len;
+                        pending++;
+                        count--;
+                    }
+                    if(count > 0)
+                    {
+                        pending->iov_base = static_cast<char *>(pending->iov_base) + remaining;
+                        pending->iov_len -= remaining;
+                    }
+                }
+            }
+        }
+    #endif
+
+    private:
+        const Range * m_range;
+        std::string_view m_separator;
+        bool m_omitEmptyStrings;
+        size_t m_size;
+    };
+
+
+    /**
+     * Lazy variant of join() for when the joined string is only going to be streamed somewhere
+     * (a file, a socket, a hash) rather than kept. Returns a JoinView: a range of the chunks that
+     * make up the joined string - elements and separators, as std::string_views - along with its
+     * total size(). It can be written straight to a std::ostream with <<, or to a file descriptor
+     * with writeTo() (writev() on POSIX systems), so the contiguous string is never built.
+     *
+     * Making the view takes one pass over the range to work out size(). Since the view only points
+     * at the range and the separator, passing a temporary range or a temporary std::string
+     * separator doesn't compile - the view would dangle as soon as the statement ended.
+     *
+     * Example:
+     *
+     * std::vector<std::string> fields = {"John", "Doe", "NY"};
+     * std::cout << joinView(fields, ",") << '\n';
+     *
+     * //Prints: John,Doe,NY
+     *
+     * @param range - Any range of std::strings, std::string_views, const char *s or other types
+     *                convertible to std::string_view. Must outlive the returned JoinView.
+     * @param separator - The characters that go between the elements. Must also outlive the returned JoinView.
+     * @param omitEmptyStrings - If true, empty elements are left out, along with their separators.
+     *
+     * @retval JoinView - A lazy range of the chunks of join(range, separator, omitEmptyStrings).
+    */
+    template<typename Range>
+    inline JoinView<Range> joinView(    const Range & range,
+                                        const std::string_view & separator,
+                                        const bool omitEmptyStrings = true  )
+    {
+        return JoinView<Range>(range, separator, omitEmptyStrings);
+    }
+
+    template<typename Range>
+    JoinView<Range> joinView(   const Range && range,
+                                const std::string_view & separator,
+                                const bool omitEmptyStrings = true  ) = delete;
+
+    template<typename Range, typename String,
+             typename = std::enable_if_t<std::is_same_v<std::decay_t<String>, std::string> && !std::is_lvalue_reference_v<String>>>
+    JoinView<Range> joinView(   const Range & range,
+                                String && separator,
+                                const bool omitEmptyStrings = true  ) = delete;
+
+
+    /**
+     * Builds up a string from many small appends. The buffer grows geometrically (at least
+     * doubling), so each append is amortized constant time no matter how the pieces are sized, and
+     * numbers are formatted with std::to_chars() straight into the buffer, with no temporary
+     * std::string per number. The finished string is moved out of the builder by str() on an
+     * rvalue (no copy), or copied once by str() on an lvalue.
+     *
+     * The functions that build strings piece by piece (csvAppend(), multiply(), wrapToWidth())
+     * have overloads that append to a StringBuilder, so their output can go into one buffer.
+     *
+     * Example:
+     *
+     * StringBuilder builder;
+     * builder.append("id=").appendNumber(42).append(',').append("ratio=").appendNumber(0.5);
+     * std::string line = std::move(builder).str();
+     *
+     * //Value of line is: "id=42,ratio=0.5"
+    */
+    class StringBuilder
     {
-        //If we are given an empty string, just return an empty vector
-        if(str.empty())
+    public:
+        StringBuilder() = default;
+
+        /**
+         * @param capacity - The number of bytes to reserve room for up front.
+        */
+        explicit StringBuilder(const size_t capacity)
         {
-            return {};
+            reserve(capacity);
         }
 
-        //Initialize all the variables we'll be using in our loop
-        std::vector<std::string> separatedStringsVec;
-        std::string separatedString;
-        size_t currSeparatorIndex;
-        size_t prevSeparatorIndex = 0;
-
-        //Loop until we've found all of the separator chars in the string_view
-        while(true)
+        /**
+         * Make sure the next capacity - length() bytes can be appended without growing the buffer.
+        */
+        void reserve(const size_t capacity)
         {
-            //Look for a separator char in the string_view
-            currSeparatorIndex = str.find(separator, prevSeparatorIndex);
-            //If the separator is not found, just get everything up until the end 
-            if(currSeparatorIndex == std::string_view::npos)
+            if(capacity > m_buffer.size())
             {
-                separatedString = str.substr(prevSeparatorIndex, str.length());
-                separatedStringsVec.push_back(separatedString);
-                break;
+                m_buffer.resize(capacity);
             }
-            //Once we've found the index, of the separator char, get all of the std::string that we jumped over since the last separator character
-            separatedString = str.substr(prevSeparatorIndex, currSeparatorIndex-prevSeparatorIndex);
-            //Push it bank into our vector
-            separatedStringsVec.push_back(separatedString);
-            //Set the prevSeparatorIndex to currSeparatorIndex now
-            prevSeparatorIndex = currSeparatorIndex + 1;
         }
 
-        //If we are omitting empty strings in our result, erase all of that we found
-        if(omitEmptyStrings)
+        StringBuilder & append(const std::string_view & str)
         {
-            separatedStringsVec.erase(std::remove(separatedStringsVec.begin(), separatedStringsVec.end(), ""), separatedStringsVec.end());
+            if(!str.empty())
+            {
+                std::memcpy(grow(str.length()), str.data(), str.length());
+            }
+            return *this;
         }
 
-        return separatedStringsVec;
-    }
-
-
-    /**
-     * 
-     * 
-     * Variant of separate that lets you separate by strings instead of chars.
-     * 
-     * Separates a std::string by a separator substring. Returns a vector of strings that 
-     * were separated by the separator substring.
-     * 
-     * Example:
-     * 
-     * std::vector<std::string> result = separate("Wakko and Yakko and Dot", " and ");
-     * 
-     * //Value of result is: {"Wakko","Yakko","Dot"}
-     *
-     * @param str - The std::string we intend to separate with this function.
-     * @param separator - The substring of str we intend to separate it by.
-     * @param omitEmptyStrings - If true, do not include empty strings in the returned vector.
-     *
-     * @retval std::vector<std::string> - A vector of substrings of the original string that have been split up by all occurrences of the separator parameter
-     */
-    inline std::vector<std::string> separate(   const std::string_view & str,
-                                                const std::string_view & separator,
-                                                const bool omitEmptyStrings = true  )
-    {
-        //If we have a single character separator, we can use a more efficient method
-        if(separator.length() == 1)
+        StringBuilder & append(const char ch)
         {
-            return stevensStringLib::separate( str, separator[0], omitEmptyStrings );
+            *grow(1) = ch;
+            return *this;
         }
 
-        //If separator is empty, split into individual characters (codepoints, not bytes - a raw
-        //byte-by-byte split would shred a multi-byte character, e.g. Cyrillic/CJK, into invalid
-        //fragments). Walks the original UTF-8 bytes once via utf8::next() and slices each
-        //codepoint's byte range directly out of str - no need to decode into a std::u32string
-        //and re-encode each codepoint back to UTF-8, since we never need the decoded codepoint
-        //value itself, only where each character starts and ends.
-        if(separator.empty())
+        /**
+         * Append count copies of ch.
+        */
+        StringBuilder & append( const size_t count,
+                                const char ch  )
         {
-            std::vector<std::string> separatedStrings;
-            separatedStrings.reserve(str.length()); // upper bound - codepoints <= bytes
+            std::memset(grow(count), ch, count);
+            return *this;
+        }
 
-            auto it = str.begin();
-            const auto end = str.end();
-            while(it != end)
+        /**
+         * Append the shortest decimal representation of number that std::to_chars() produces - for
+         * floating-point numbers, the shortest that reads back as the same value.
+        */
+        template<typename Number>
+        StringBuilder & appendNumber(const Number number)
+        {
+            static_assert(std::is_arithmetic_v<Number> && !std::is_same_v<Number, bool>, "appendNumber() takes an integer or floating-point number");
+            //Enough for any integer in base 10 or any floating-point number in its shortest form
+            char digits[64];
+        #if !defined(__cpp_lib_to_chars)
+            if constexpr(std::is_floating_point_v<Number>)
             {
-                auto charStart = it;
-                utf8::next(it, end); // advances it past one codepoint
-                separatedStrings.emplace_back(charStart, it);
+                //No floating-point std::to_chars() in this standard library - print enough digits to round-trip
+                const int length = std::snprintf(digits, sizeof(digits), "%.*g", std::numeric_limits<Number>::max_digits10, static_cast<double>(number));
+                return append(std::string_view(digits, static_cast<size_t>(length)));
+            }
+            else
+        #endif
+            {
+                const std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), number);
+                return append(std::string_view(digits, static_cast<size_t>(result.ptr - digits)));
             }
-            return separatedStrings;
         }
 
-        std::vector<std::string> separatedStrings;
-        separatedStrings.reserve(8); // Reasonable default to avoid vector reallocations
-        
-        size_t start = 0;
-        size_t pos = 0;
-        
-        // Direct search without building intermediate strings
-        while((pos = str.find(separator, start)) != std::string_view::npos)
+        /**
+         * @retval size_t - The number of bytes appended so far.
+        */
+        size_t length() const
         {
-            if(pos > start || !omitEmptyStrings)
-            {
-                // Construct std::string directly in vector memory - no temporary objects
-                separatedStrings.emplace_back(str.data() + start, pos - start);
-            }
-            start = pos + separator.length();
+            return m_length;
         }
-        
-        // Handle final segment
-        if(start < str.length() || (!omitEmptyStrings && start == str.length()))
+
+        bool empty() const
         {
-            separatedStrings.emplace_back(str.data() + start, str.length() - start);
+            return m_length == 0;
         }
 
-        return separatedStrings;
-    }
+        /**
+         * @retval size_t - The number of bytes the builder can hold before it next grows.
+        */
+        size_t capacity() const
+        {
+            return m_buffer.size();
+        }
 
+        /**
+         * Forget everything appended so far, keeping the buffer for reuse.
+        */
+        void clear()
+        {
+            m_length = 0;
+        }
 
-    /**
-     * @brief Given a vector of strings, concatenate them all into a single string, separating each std::string element 
-     * in the final returned std::string by a given separator string. 
-     * 
-     * Essentially, reverses the operation of the separate function.
-     * 
-     * @param vec The vector of stringlike objects we wish to concatenate together
-     * @param separator A std::string of characters that will be placed between all concatenated elements
-     * 
-     * @returns A std::string of all of the std::string elements in the vector concatenated with the separator std::string between each element.
-     */
-    inline std::string join(    const std::vector<std::string> & vec,
-                                const std::string & separator,
-                                const bool omitEmptyStrings = true  )
-    {
-        //If an empty vector is passed in for vec, return the empty string.
-        if(vec.size() == 0)
+        /**
+         * @retval std::string_view - What has been appended so far, valid until the next append.
+        */
+        std::string_view view() const
         {
-            return "";
+            return std::string_view(m_buffer.data(), m_length);
+        }
+
+        /**
+         * @retval std::string - A copy of what has been appended so far.
+        */
+        std::string str() const &
+        {
+            return std::string(view());
         }
 
-        //The std::string we will return
-        std::string str = "";
-        bool first = true;
+        /**
+         * @retval std::string - What has been appended so far, moved out of the builder without
+         *         copying. The builder is left empty.
+        */
+        std::string str() &&
+        {
+            m_buffer.resize(m_length);
+            m_length = 0;
+            return std::move(m_buffer);
+        }
 
-        //Concatenate the vector together element-by-element
-        for(int i = 0; i < vec.size(); i++)
+    private:
+        /**
+         * Extend the builder by extra bytes, growing the buffer if needed.
+         *
+         * @retval char * - Where the extra bytes go.
+        */
+        char * grow(const size_t extra)
         {
-            //Check to see if the element at the current index is empty and if we're omitting empty strings. If so, we'll skip to the next index.
-            if(vec[i].empty() && omitEmptyStrings)
-            {
-                continue;
-            }
-            //Add separator before non-first elements
-            if(!first)
+            if(m_buffer.size() - m_length < extra)
             {
-                str += separator;
+                m_buffer.resize(std::max({m_buffer.size() * 2, m_length + extra, size_t(64)}));
             }
-            //For each element in the vector, concatenate it onto the end of the std::string
-            str += vec[i];
-            first = false;
+            char * out = m_buffer.data() + m_length;
+            m_length += extra;
+            return out;
         }
 
-        //Return the joined vector of strings
-        return str;
-    }
+        //Bytes past m_length are spare room, so the buffer is only resized when it fills up
+        std::string m_buffer;
+        size_t m_length = 0;
+    };
 
 
     /**
@@ -1041,6 +7145,36 @@ namespace stevensStringLib
     }
 
 
+    /**
+     * Variant of trim that erases every leading and trailing character of str that's a member of a
+     * CharSet, rather than a fixed number of characters.
+     *
+     * Example:
+     *
+     * const CharSet quotesAndSpaces("\"' ");
+     * std::string result = trim(" \"hello world\" ", quotesAndSpaces);
+     *
+     * //Value of result is: "hello world"
+     *
+     * @param str - A std::string we would like to trim the characters from.
+     * @param set - The compiled set of characters to trim from the beginning and end of str.
+     *
+     * @retval std::string - str without its leading and trailing members of set.
+     */
+    inline std::string trim(    const std::string_view & str,
+                                const CharSet & set   )
+    {
+        const size_t strBegin = findFirstNotOf(str, set);
+        if(strBegin == std::string::npos)
+        {
+            return "";
+        }
+        const size_t strEnd = findLastNotOf(str, set);
+
+        return std::string(str.substr(strBegin, strEnd - strBegin + 1));
+    }
+
+
     /**
      * Removes all tabs, spaces, newlines, and anything else from a std::string that is defined as whitespace in the current locale.
      * 
@@ -1148,19 +7282,83 @@ namespace stevensStringLib
                                         const std::string_view & keyValueSeparator = ":",
                                         const std::string_view & pairSeparator =     "," )
     {
-        std::string stringifiedMap = "";
-        //Iterate through the unordered map, appending each pair to the std::string
-        for(const auto & [key,value] : map )
+        //Size the string exactly up front, then copy each pair into it
+        std::string stringifiedMap(detail::stringifiedMapLength(map, keyValueSeparator, pairSeparator), '\0');
+        detail::writeStringifiedMap(stringifiedMap.data(), map, keyValueSeparator, pairSeparator);
+        return stringifiedMap;
+    }
+
+
+    /**
+     * Variant of stringifyMap that appends the result to an existing string instead of returning
+     * a new one, so a single buffer can be reused across many calls. out grows at most once per call.
+     *
+     *  @param map - The map or unordered_map with std::string keys and values which we intend to turn into a string.
+     *  @param out - The string the key-value pairs are appended to.
+     *  @param keyValueSeparator - The std::string that separates keys from their values.
+     *  @param pairSeparator - The std::string that separates key-value pairs.
+     *
+     *  @retval None, but operates by reference to append to out.
+    */
+    template<typename T>
+    inline void stringifyMapInto(   const T & map,
+                                    std::string & out,
+                                    const std::string_view & keyValueSeparator = ":",
+                                    const std::string_view & pairSeparator =     "," )
+    {
+        const size_t oldLength = out.length();
+        out.resize(oldLength + detail::stringifiedMapLength(map, keyValueSeparator, pairSeparator));
+        detail::writeStringifiedMap(out.data() + oldLength, map, keyValueSeparator, pairSeparator);
+    }
+
+
+    /**
+     * Variant of stringifyMapInto that writes into the fixed buffer [first, last), reporting
+     * overflow the way std::to_chars() does. Nothing is written if the result doesn't fit. No null
+     * terminator is written.
+     *
+     *  @param map - The map or unordered_map with std::string keys and values which we intend to turn into a string.
+     *  @param first - The start of the buffer to write into.
+     *  @param last - One past the end of the buffer to write into.
+     *  @param keyValueSeparator - The std::string that separates keys from their values.
+     *  @param pairSeparator - The std::string that separates key-value pairs.
+     *
+     *  @retval std::to_chars_result - On success, {one past the last char written, std::errc()}.
+     *          If the buffer is too small, {last, std::errc::value_too_large}.
+    */
+    template<typename T>
+    inline std::to_chars_result stringifyMapInto(   const T & map,
+                                                    char * first,
+                                                    char * last,
+                                                    const std::string_view & keyValueSeparator = ":",
+                                                    const std::string_view & pairSeparator =     "," )
+    {
+        if(detail::stringifiedMapLength(map, keyValueSeparator, pairSeparator) > static_cast<size_t>(last - first))
         {
-            if(!stringifiedMap.empty())
-            {
-                stringifiedMap += pairSeparator;
-            }
-            stringifiedMap += key;
-            stringifiedMap += keyValueSeparator;
-            stringifiedMap += value;
+            return {last, std::errc::value_too_large};
         }
-        return stringifiedMap;
+        return {detail::writeStringifiedMap(first, map, keyValueSeparator, pairSeparator), std::errc()};
+    }
+
+
+    /**
+     * Variant of stringifyMapInto that writes through an output iterator of chars, e.g. a
+     * std::back_inserter or a std::ostreambuf_iterator.
+     *
+     *  @param map - The map or unordered_map with std::string keys and values which we intend to turn into a string.
+     *  @param out - The output iterator to write the key-value pairs through.
+     *  @param keyValueSeparator - The std::string that separates keys from their values.
+     *  @param pairSeparator - The std::string that separates key-value pairs.
+     *
+     *  @retval OutputIterator - The iterator one past the last char written.
+    */
+    template<typename T, typename OutputIterator>
+    inline OutputIterator stringifyMapInto( const T & map,
+                                            OutputIterator out,
+                                            const std::string_view & keyValueSeparator = ":",
+                                            const std::string_view & pairSeparator =     "," )
+    {
+        return detail::writeStringifiedMap(out, map, keyValueSeparator, pairSeparator);
     }
 
 
@@ -1207,50 +7405,44 @@ namespace stevensStringLib
 
 
     /**
-     * Given a std::string and a maximum display width (in terminal columns), wrap the text by
-     * adding newlines between words so it fits within that width.
+     * Variant of wrapToWidth that appends the wrapped text to a StringBuilder.
      *
-     * Wraps by display width, not byte count or codepoint count - a line of CJK/fullwidth text
-     * wraps at the correct on-screen column instead of overflowing by up to 2x (each such
-     * codepoint occupies 2 terminal columns). Plain ASCII content wraps identically to before,
-     * since codepoint count, byte count, and display width all coincide for it.
-     *
-     * @param str - The std::string which we wish to wrap to a certain width.
+     * @param str - The text which we wish to wrap to a certain width.
      * @param wrapWidth - The maximum display width (terminal columns) of every wrapped line
      *                    after the first.
-     * @param firstLineWidth - The maximum display width of only the very first wrapped segment,
-     *                         for callers continuing text onto an already-partially-filled row
-     *                         (e.g. printing several differently-styled pieces on the same visual
-     *                         line - see stevensTerminal's curses_wwrap_withTokens()). Pass
-     *                         std::string::npos (the default) to use wrapWidth for every line,
-     *                         including the first - the ordinary case of starting at a fresh line.
+     * @param out - The StringBuilder the wrapped text is appended to.
+     * @param firstLineWidth - The maximum display width of only the very first wrapped segment.
      *
-     * @retval std::string - A modified version of the parameter str, with newlines added to it so
-     *         that it fits within the given display width.
+     * @retval None, but operates by reference to append to out.
     */
-    inline std::string wrapToWidth(     const std::string & str,
-                                        size_t wrapWidth,
-                                        size_t firstLineWidth = std::string::npos   )
+    inline void wrapToWidth(    const std::string_view & str,
+                                size_t wrapWidth,
+                                StringBuilder & out,
+                                size_t firstLineWidth = std::string::npos   )
     {
-        //If we have a wrapWidth of zero, we can't fit anything in a column of size zero. Return the empty string.
+        //If we have a wrapWidth of zero, we can't fit anything in a column of size zero.
         if(wrapWidth == 0)
         {
-            return "";
+            return;
         }
         if(firstLineWidth == std::string::npos)
         {
             firstLineWidth = wrapWidth;
         }
 
-        std::istringstream in(str);
-        std::string line;
-        std::string output = "";
-        int numberOfLines = countLines(str);
-        int currLineNum = 0;
         bool firstSegment = true;
-
-        while(getline(in,line))
+        //Go line by line, the way std::getline() would (a final newline doesn't start another line)
+        size_t lineStart = 0;
+        while(lineStart < str.length())
         {
+            size_t lineEnd = str.find('\n', lineStart);
+            if(lineEnd == std::string_view::npos)
+            {
+                lineEnd = str.length();
+            }
+            std::string_view line = str.substr(lineStart, lineEnd - lineStart);
+            lineStart = lineEnd + 1;
+
             while(!line.empty())
             {
                 size_t budget = firstSegment ? firstLineWidth : wrapWidth;
@@ -1260,19 +7452,48 @@ namespace stevensStringLib
                 //If the whole remainder of the line fits, output it as-is and we're done with this line
                 if(cut.segmentEnd == line.length() && cut.nextStart == line.length())
                 {
-                    output += line;
+                    out.append(line);
                     break;
                 }
                 //Otherwise, output the piece that fits and continue with what's left
-                output += line.substr(0, cut.segmentEnd) + "\n";
+                out.append(line.substr(0, cut.segmentEnd)).append('\n');
                 line = line.substr(cut.nextStart);
             }
-            currLineNum++;
             //Add a new line when printing the next line from the std::string
-            output += "\n";
+            out.append('\n');
         }
+    }
 
-        return output;
+
+    /**
+     * Given a std::string and a maximum display width (in terminal columns), wrap the text by
+     * adding newlines between words so it fits within that width.
+     *
+     * Wraps by display width, not byte count or codepoint count - a line of CJK/fullwidth text
+     * wraps at the correct on-screen column instead of overflowing by up to 2x (each such
+     * codepoint occupies 2 terminal columns). Plain ASCII content wraps identically to before,
+     * since codepoint count, byte count, and display width all coincide for it.
+     *
+     * @param str - The std::string which we wish to wrap to a certain width.
+     * @param wrapWidth - The maximum display width (terminal columns) of every wrapped line
+     *                    after the first.
+     * @param firstLineWidth - The maximum display width of only the very first wrapped segment,
+     *                         for callers continuing text onto an already-partially-filled row
+     *                         (e.g. printing several differently-styled pieces on the same visual
+     *                         line - see stevensTerminal's curses_wwrap_withTokens()). Pass
+     *                         std::string::npos (the default) to use wrapWidth for every line,
+     *                         including the first - the ordinary case of starting at a fresh line.
+     *
+     * @retval std::string - A modified version of the parameter str, with newlines added to it so
+     *         that it fits within the given display width.
+    */
+    inline std::string wrapToWidth(     const std::string & str,
+                                        size_t wrapWidth,
+                                        size_t firstLineWidth = std::string::npos   )
+    {
+        StringBuilder output(str.length() + str.length() / 8);
+        wrapToWidth(str, wrapWidth, output, firstLineWidth);
+        return std::move(output).str();
     }
 
 
@@ -1624,6 +7845,37 @@ namespace stevensStringLib
     }
 
 
+    /**
+     * Variant of multiply that appends str to a StringBuilder x times.
+     *
+     * @param str - The std::string we are multiplying.
+     * @param x - The number of times to append str.
+     * @param out - The StringBuilder str is appended to.
+     *
+     * @retval None, but operates by reference to append to out.
+     */
+    inline void multiply(   const std::string_view str,
+                            const int x,
+                            StringBuilder & out )
+    {
+        if(x <= 0 || str.empty())
+        {
+            return;
+        }
+        const size_t start = out.length();
+        const size_t total = str.length() * x;
+        //Reserved up front, so the copies below never move the bytes they copy from
+        out.reserve(start + total);
+        out.append(str);
+        //Double what's been written each time, rather than appending str x times
+        while(out.length() - start < total)
+        {
+            const size_t written = out.length() - start;
+            out.append(out.view().substr(start, std::min(written, total - written)));
+        }
+    }
+
+
     /**
      * @brief Given a std::string str, concatenate it onto an empty std::string a given amount of times x, creating a multiply-like effect.
      * 
@@ -1635,12 +7887,13 @@ namespace stevensStringLib
     inline std::string multiply(    const std::string_view str,
                                     const int x )
     {
-        std::string multipliedString;
-        for(int i = 0; i < x; i++)
+        if(x <= 0)
         {
-            multipliedString += str;
+            return "";
         }
-        return multipliedString;
+        StringBuilder multipliedString(str.length() * x);
+        multiply(str, x, multipliedString);
+        return std::move(multipliedString).str();
     }
 
 
@@ -1851,6 +8104,51 @@ namespace stevensStringLib
     }
 
 
+    /**
+     * Variant of replaceSubstr that replaces instances of a precompiled Searcher's needle. Going
+     * from the left, the result is built in a single pass over str instead of replacing in place
+     * one occurrence at a time; going from the right, this is the same as the substring variant.
+     *
+     * @param str The std::string we are replacing instances of the target substring within.
+     * @param target The Searcher for the substring we are replacing with replaceSubstr in str.
+     * @param replaceSubstr The substring we are using to replace instances of the target substring.
+     * @param quantity The number of times we wish to make replacements. By default, it replaces all occurrences of the target substring.
+     * @param startFrom The side of the std::string we would like to begin making replacements from. By default, we begin from the left. Valid values are "left" and "right".
+     */
+    inline std::string replaceSubstr(   const std::string_view & str,
+                                        const Searcher & target,
+                                        const std::string & replaceSubstr,
+                                        size_t quantity = std::string::npos,
+                                        const std::string & startFrom = "left"  )
+    {
+        if(target.length() == 0 || startFrom != "left")
+        {
+            return stevensStringLib::replaceSubstr( std::string(str),
+                                                    target.needle(),
+                                                    replaceSubstr,
+                                                    quantity,
+                                                    startFrom   );
+        }
+
+        std::string result;
+        result.reserve(str.length());
+        size_t copiedUpTo = 0; //Everything in str before this index is already in result
+        size_t replacementsMade = 0;
+        size_t occurrencePosition;
+        while(  replacementsMade < quantity
+                && (occurrencePosition = target.find(str, copiedUpTo)) != std::string_view::npos  )
+        {
+            result.append(str.substr(copiedUpTo, occurrencePosition - copiedUpTo));
+            result.append(replaceSubstr);
+            copiedUpTo = occurrencePosition + target.length();
+            replacementsMade++;
+        }
+        result.append(str.substr(copiedUpTo));
+
+        return result;
+    }
+
+
     /**
      * @brief Given a floating point number num, remove trailing zeroes up to a certain point of
      *        given precision. Return the resulting number as a string.
@@ -1903,8 +8201,30 @@ namespace stevensStringLib
             csvs = valueToAdd;
             return;
         }
-        //Otherwise, we add the delimiter character combined with the valueToAdd to the end of csvs
-        csvs += delimiter + valueToAdd;
+        //Otherwise, we add the delimiter character and then the valueToAdd to the end of csvs
+        csvs += delimiter;
+        csvs += valueToAdd;
+    }
+
+
+    /**
+     * Variant of csvAppend that appends to a StringBuilder, for building up a long list of values.
+     *
+     * @param csvs A StringBuilder holding values delimited by the parameter delimiter, which we will add a value onto the end of
+     * @param valueToAdd The value to append to the end of csvs
+     * @param delimiter The character delimiting the csvs string. ',' by default.
+     *
+     * @retval None, but operates by reference to add value to the end of parameter csvs.
+     */
+    inline void csvAppend(  StringBuilder & csvs,
+                            const std::string_view & valueToAdd,
+                            const char delimiter = ',')
+    {
+        if(!csvs.empty())
+        {
+            csvs.append(delimiter);
+        }
+        csvs.append(valueToAdd);
     }
 
 
@@ -3,7 +3,7 @@
  * @brief Unit tests for string conversion and formatting functions
  *
  * Tests for: stringToBool, boolToString, charToString, format,
- *            replaceSubstr, mapifyString, stringifyMap
+ *            replaceSubstr, mapifyString, stringifyMap, stringifyMapInto
  */
 
 #include <gtest/gtest.h>
@@ -235,6 +235,15 @@ TEST(ReplaceSubstr, ReplacementLongerThanTarget) {
     EXPECT_EQ(result, "a and b and c");
 }
 
+TEST(ReplaceSubstr, Searcher_MatchesSubstringVariant) {
+    std::string str = "the fox and the other fox and the fox";
+    Searcher fox("fox");
+    EXPECT_EQ(replaceSubstr(str, fox, "wolf"), replaceSubstr(str, "fox", "wolf"));
+    EXPECT_EQ(replaceSubstr(str, fox, "wolf", 2), replaceSubstr(str, "fox", "wolf", 2));
+    EXPECT_EQ(replaceSubstr(str, fox, "wolf", 1, "right"), replaceSubstr(str, "fox", "wolf", 1, "right"));
+    EXPECT_EQ(replaceSubstr("aaaa", Searcher("aa"), "a"), replaceSubstr("aaaa", "aa", "a"));
+}
+
 // ============================================================================
 // TESTS - mapifyString() and stringifyMap()
 // ============================================================================
@@ -304,6 +313,37 @@ TEST(StringifyMap, EmptyMap) {
     EXPECT_EQ(result, "");
 }
 
+TEST(StringifyMap, IntoSinks) {
+    std::map<std::string, std::string> map = {{"a", "1"}, {"b", "2"}};
+
+    std::string body = "map=";
+    stringifyMapInto(map, body, "=", "&");
+    EXPECT_EQ(body, "map=a=1&b=2");
+
+    char buffer[8];
+    auto result = stringifyMapInto(map, buffer, buffer + sizeof(buffer));
+    EXPECT_EQ(result.ec, std::errc());
+    EXPECT_EQ(std::string(buffer, result.ptr), "a:1,b:2");
+    result = stringifyMapInto(map, buffer, buffer + 6);
+    EXPECT_EQ(result.ec, std::errc::value_too_large);
+    EXPECT_EQ(result.ptr, buffer + 6);
+
+    std::string viaIterator;
+    stringifyMapInto(map, std::back_inserter(viaIterator));
+    EXPECT_EQ(viaIterator, stringifyMap(map));
+
+    std::map<std::string, std::string> emptyPair = {{"", ""}};
+    std::string appended = "x";
+    stringifyMapInto(emptyPair, appended, "", ",");
+    EXPECT_EQ(appended, "x");
+
+    std::map<std::string, char> grades = {{"amy", 'A'}, {"bo", 'C'}};
+    EXPECT_EQ(stringifyMap(grades), "amy:A,bo:C");
+    std::string gradesBody = ">";
+    stringifyMapInto(grades, gradesBody, "=", "&");
+    EXPECT_EQ(gradesBody, ">amy=A&bo=C");
+}
+
 // Property: mapifyString and stringifyMap are inverses
 TEST(MapConversion, RoundtripProperty) {
     std::map<std::string, std::string> original = {
@@ -353,6 +393,14 @@ TEST(CsvAppend, CustomDelimiter) {
     EXPECT_EQ(csvs, "apple;banana;cherry");
 }
 
+TEST(CsvAppend, IntoStringBuilder) {
+    StringBuilder csvs;
+    csvAppend(csvs, "apple");
+    csvAppend(csvs, std::string("banana"));
+    csvAppend(csvs, "", ';');
+    EXPECT_EQ(csvs.view(), "apple,banana;");
+}
+
 // ============================================================================
 // TESTS - unorderedMapifyString()
 // ============================================================================
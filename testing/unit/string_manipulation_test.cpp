@@ -2,12 +2,17 @@
  * @file string_manipulation_test.cpp
  * @brief Unit tests for string manipulation functions
  *
- * Tests for: separate, join, trim, removeWhitespace, trimWhitespace,
- *            toUpper, toLower, cap1stChar, reverse, scramble, multiply
+ * Tests for: separate, separateCodepoints, separateN, separateInto, TokenTable, splitView,
+ *            forEachCsvRecord, parseCsv, forEachToken, join, joinInto, joinView, trim (by count and by CharSet), removeWhitespace, trimWhitespace,
+ *            toUpper, toLower, cap1stChar, reverse, scramble, multiply, StringBuilder
  */
 
 #include <gtest/gtest.h>
 #include <algorithm>
+#include <random>
+#include <sstream>
+#include <cstdio>
+#include <list>
 #include "../../stevensStringLib.h"
 #include "../fixtures/test_data.h"
 
@@ -80,6 +85,67 @@ TEST(Separate, EmptySeparator_MultiByteSplitsIntoWholeCodepoints) {
     EXPECT_EQ(result, expected);
 }
 
+TEST(Separate, EmptySeparator_MultiByteAcrossSimdBlocks) {
+    // Multi-byte characters at every offset around the 16/32-byte ASCII-run blocks
+    const std::vector<std::string> multiByte = {"б", "€", "😀"};
+    for (size_t offset = 0; offset < 70; ++offset) {
+        std::string input(offset, 'x');
+        std::vector<std::string> expected(offset, "x");
+        for (const std::string& ch : multiByte) {
+            input += ch + "yz";
+            expected.insert(expected.end(), {ch, "y", "z"});
+        }
+        EXPECT_EQ(separate(input, ""), expected) << offset;
+    }
+}
+
+TEST(SeparateFixed, CharSeparator_MatchesRuntimeSeparate) {
+    std::vector<std::string> expected = {"John", "Gina", "Sebastian"};
+    EXPECT_EQ(separate<','>("John,Gina,Sebastian"), expected);
+    EXPECT_EQ(separate<'\n'>("a\n\nb\n", false), separate("a\n\nb\n", '\n', false));
+    EXPECT_TRUE(separate<','>("").empty());
+}
+
+TEST(SeparateFixed, MultiCharSeparator_MatchesRuntimeSeparate) {
+    std::vector<std::string> expected = {"std", "chrono", "seconds"};
+    EXPECT_EQ((separate<':', ':'>("std::chrono::seconds")), expected);
+
+    std::mt19937 rng(17);
+    for (int trial = 0; trial < 300; ++trial) {
+        std::string input;
+        size_t length = rng() % 80;
+        for (size_t i = 0; i < length; ++i) input += ":a b"[rng() % 4];
+        for (bool omit : {true, false}) {
+            EXPECT_EQ((separate<':', ':'>(input, omit)), separate(input, "::", omit)) << input;
+            EXPECT_EQ((separate<' ', 'a', ' '>(input, omit)), separate(input, " a ", omit)) << input;
+        }
+    }
+}
+
+TEST(SeparateCodepoints, ViewsIntoSource) {
+    const std::string input = "añb€";
+    std::vector<std::string_view> result = separateCodepoints(input);
+    std::vector<std::string_view> expected = {"a", "ñ", "b", "€"};
+    EXPECT_EQ(result, expected);
+    EXPECT_EQ(result[1].data(), input.data() + 1);
+    EXPECT_TRUE(separateCodepoints("").empty());
+}
+
+TEST(SeparateCodepoints, SizedToCodepointsNotBytes) {
+    std::string cjk;
+    for (int i = 0; i < 1000; ++i) cjk += "世界";
+    std::vector<std::string_view> result = separateCodepoints(cjk);
+    EXPECT_EQ(result.size(), 2000u);
+    EXPECT_EQ(result.capacity(), result.size());
+}
+
+TEST(SeparateCodepoints, MatchesSeparateWithEmptySeparator) {
+    std::string input;
+    for (int i = 0; i < 50; ++i) input += "plain ascii text, then ünïcödé and 漢字 ";
+    std::vector<std::string_view> views = separateCodepoints(input);
+    EXPECT_EQ(std::vector<std::string>(views.begin(), views.end()), separate(input, ""));
+}
+
 TEST(Separate, NoSeparatorFound_ReturnsWholeString) {
     auto result = separate("no separators here", "@");
     EXPECT_EQ(result.size(), 1);
@@ -95,6 +161,630 @@ TEST(Separate, LargeString_WorksCorrectly) {
     EXPECT_EQ(result.size(), 7742);
 }
 
+// Reference split: the original find()-based algorithm, used to check the SIMD scanning path
+static std::vector<std::string> referenceSeparate(const std::string& str, char sep, bool omit) {
+    std::vector<std::string> result;
+    if (str.empty()) return result;
+    size_t start = 0;
+    while (true) {
+        size_t pos = str.find(sep, start);
+        std::string piece = str.substr(start, pos == std::string::npos ? std::string::npos : pos - start);
+        if (!piece.empty() || !omit) result.push_back(piece);
+        if (pos == std::string::npos) break;
+        start = pos + 1;
+    }
+    return result;
+}
+
+TEST(Separate, CharSeparator_MatchesReferenceAcrossSimdBlocks) {
+    // Lengths straddle the 16/32-byte SIMD block sizes; separator densities from sparse to all-separators
+    std::mt19937 gen(42);
+    for (size_t length : {1, 15, 16, 17, 31, 32, 33, 63, 64, 65, 200}) {
+        for (int density : {0, 5, 50, 100}) {
+            std::string input;
+            for (size_t i = 0; i < length; ++i) {
+                input += (static_cast<int>(gen() % 100) < density) ? ',' : static_cast<char>('a' + gen() % 26);
+            }
+            for (bool omit : {true, false}) {
+                EXPECT_EQ(separate(input, ',', omit), referenceSeparate(input, ',', omit))
+                    << "input='" << input << "', omit=" << omit;
+            }
+        }
+    }
+}
+
+TEST(Separate, CharSeparator_HighBitSeparator) {
+    // A separator byte >= 0x80 must compare correctly as a signed char in the SIMD kernels
+    std::string input = "a\xC2" "b\xC2\xC2" "c";
+    std::vector<std::string> expected = {"a", "b", "c"};
+    EXPECT_EQ(separate(input, '\xC2'), expected);
+}
+
+TEST(SeparateKernels, AllVariantsFindSamePositions) {
+    std::string input(1000, 'x');
+    for (size_t i = 0; i < input.size(); i += 7) input[i] = ';';
+    auto collect = [&](auto scan) {
+        std::vector<size_t> positions;
+        auto visitor = [&](size_t index) { positions.push_back(index); return true; };
+        scan(visitor);
+        return positions;
+    };
+    auto expected = collect([&](auto& v) { detail::forEachCharPositionScalar(input, 0, ';', v); });
+    EXPECT_EQ(expected.size(), 143);
+#if defined(STEVENSSTRINGLIB_X86_SIMD)
+    EXPECT_EQ(collect([&](auto& v) { detail::forEachCharPositionSse2(input, 0, ';', v); }), expected);
+#endif
+#if defined(STEVENSSTRINGLIB_AVX2_DISPATCH)
+    if (detail::cpuSupportsAvx2()) {
+        EXPECT_EQ(collect([&](auto& v) { detail::forEachCharPositionAvx2(input, 0, ';', v); }), expected);
+        EXPECT_EQ(detail::countCharAvx2(input, 0, ';'), expected.size());
+    }
+#endif
+#if defined(STEVENSSTRINGLIB_X86_SIMD)
+    EXPECT_EQ(detail::countCharSse2(input, 0, ';'), expected.size());
+#endif
+    EXPECT_EQ(detail::countChar(input, ';'), expected.size());
+}
+
+TEST(SeparateKernels, VisitorReturningFalse_StopsScan) {
+    std::vector<size_t> positions;
+    bool completed = detail::forEachCharPosition(std::string(100, ','), ',', [&](size_t index) {
+        positions.push_back(index);
+        return positions.size() < 3;
+    });
+    EXPECT_FALSE(completed);
+    EXPECT_EQ(positions, (std::vector<size_t>{0, 1, 2}));
+}
+
+// ============================================================================
+// TESTS - separate() with a CharSet of delimiters
+// ============================================================================
+
+TEST(SeparateCharSet, SplitsOnAnyDelimiter) {
+    auto result = separate("red, green;blue\tcyan", CharSet(" ,;\t"));
+    std::vector<std::string> expected = {"red", "green", "blue", "cyan"};
+    EXPECT_EQ(result, expected);
+}
+
+TEST(CharSet, MembershipAndEmptiness) {
+    CharSet set("ab");
+    EXPECT_TRUE(set.contains('a'));
+    EXPECT_FALSE(set.contains('c'));
+    EXPECT_FALSE(set.empty());
+    EXPECT_TRUE(CharSet().empty());
+}
+
+TEST(SeparateCharSet, KeepsEmptyStringsWhenAsked) {
+    auto result = separate("a, b", CharSet(" ,"), false);
+    std::vector<std::string> expected = {"a", "", "b"};
+    EXPECT_EQ(result, expected);
+    EXPECT_TRUE(separate("", CharSet(","), false).empty());
+}
+
+TEST(SeparateCharSet, SingleCharSet_MatchesCharSeparator) {
+    for (std::string input : {"a,b,c", "a,,c", ",a,", ",,,", "no-separator"}) {
+        for (bool omit : {true, false}) {
+            EXPECT_EQ(separate(input, CharSet(","), omit), separate(input, ',', omit));
+        }
+    }
+}
+
+TEST(SeparateCharSet, NonAsciiMembersAndBytes) {
+    // Non-ASCII set members take the scalar bitmap path; non-ASCII input bytes must never
+    // false-match an ASCII-only set in the SIMD path
+    std::string input(100, 'x');
+    input[10] = '\xAC';
+    input[40] = ';';
+    input[70] = '\xFF';
+    EXPECT_EQ(separate(input, CharSet(";")).size(), 2);
+    EXPECT_EQ(separate(input, CharSet("\xAC\xFF")).size(), 3);
+    EXPECT_EQ(separate(input, CharSet(std::string_view("\0", 1))).size(), 1);
+}
+
+TEST(SeparateCharSet, KernelsAgreeAcrossSimdBlocks) {
+    CharSet set(" ,;\t");
+    std::mt19937 gen(7);
+    const std::string alphabet = "abc ,;\t\xC3\xA9";
+    std::string input;
+    for (int i = 0; i < 500; ++i) input += alphabet[gen() % alphabet.size()];
+
+    std::vector<size_t> expected;
+    for (size_t i = 0; i < input.size(); ++i) {
+        if (set.contains(input[i])) expected.push_back(i);
+    }
+    std::vector<size_t> positions;
+    detail::forEachCharSetPosition(input, set.tables(), [&](size_t index) {
+        positions.push_back(index);
+        return true;
+    });
+    EXPECT_EQ(positions, expected);
+}
+
+// ============================================================================
+// TESTS - separateInto()
+// ============================================================================
+
+TEST(SeparateInto, MatchesSeparate) {
+    std::vector<std::string> out;
+    for (std::string input : {"a,b,c", "a,,c", ",a,", ",,,", "", "no-separator"}) {
+        for (bool omit : {true, false}) {
+            separateInto(input, ',', out, omit);
+            EXPECT_EQ(out, separate(input, ',', omit)) << "input='" << input << "', omit=" << omit;
+            separateInto(input, ",", out, omit);
+            EXPECT_EQ(out, separate(input, ",", omit)) << "input='" << input << "', omit=" << omit;
+            separateInto(input, CharSet(","), out, omit);
+            EXPECT_EQ(out, separate(input, CharSet(","), omit)) << "input='" << input << "', omit=" << omit;
+        }
+    }
+    separateInto("Wakko and Yakko and Dot", " and ", out);
+    EXPECT_EQ(out, (std::vector<std::string>{"Wakko", "Yakko", "Dot"}));
+    separateInto("aбc", "", out);
+    EXPECT_EQ(out, (std::vector<std::string>{"a", "б", "c"}));
+}
+
+TEST(SeparateInto, ReusesElementBuffers) {
+    std::vector<std::string> out;
+    separateInto("a long first field that outgrows SSO,second field also past SSO", ',', out);
+    ASSERT_EQ(out.size(), 2);
+    const char* firstBuffer = out[0].data();
+    const std::string* vectorStorage = out.data();
+
+    separateInto("short,fields", ',', out);
+    EXPECT_EQ(out, (std::vector<std::string>{"short", "fields"}));
+    EXPECT_EQ(out.data(), vectorStorage);     // Vector not reallocated
+    EXPECT_EQ(out[0].data(), firstBuffer);    // String buffer reused by assign()
+}
+
+TEST(SeparateInto, ShrinksAndGrowsToPieceCount) {
+    std::vector<std::string> out;
+    separateInto("a,b,c,d", ',', out);
+    EXPECT_EQ(out.size(), 4);
+    separateInto("x", ',', out);
+    EXPECT_EQ(out, (std::vector<std::string>{"x"}));
+    separateInto("1,2,3", ',', out);
+    EXPECT_EQ(out, (std::vector<std::string>{"1", "2", "3"}));
+}
+
+TEST(SeparateInto, StringViewContainer_PointsIntoSource) {
+    std::string input = "John,Gina";
+    std::vector<std::string_view> out = {"stale", "stale", "stale"};
+    separateInto(input, ',', out);
+    ASSERT_EQ(out.size(), 2);
+    EXPECT_EQ(out[1], "Gina");
+    EXPECT_EQ(out[1].data(), input.data() + 5);
+}
+
+// ============================================================================
+// TESTS - TokenTable
+// ============================================================================
+
+TEST(TokenTable, SeparateInto_MatchesSeparate) {
+    TokenTable table;
+    for (std::string input : {"a,b,c", "a,,c", ",a,", ",,,", "", "no-separator"}) {
+        for (bool omit : {true, false}) {
+            separateInto(input, ',', table, omit);
+            EXPECT_EQ(table.toVector(), separate(input, ',', omit)) << "input='" << input << "', omit=" << omit;
+            separateInto(input, CharSet(","), table, omit);
+            EXPECT_EQ(table.toVector(), separate(input, CharSet(","), omit));
+        }
+    }
+    separateInto("Wakko and Yakko and Dot", " and ", table);
+    EXPECT_EQ(table.toVector(), (std::vector<std::string>{"Wakko", "Yakko", "Dot"}));
+}
+
+TEST(TokenTable, IndexingAndIteration) {
+    TokenTable table;
+    separateInto("alpha,,beta,gamma", ',', table, false);
+    ASSERT_EQ(table.size(), 4);
+    EXPECT_EQ(table[0], "alpha");
+    EXPECT_EQ(table[1], "");
+    EXPECT_EQ(table[3], "gamma");
+
+    std::vector<std::string_view> iterated(table.begin(), table.end());
+    EXPECT_EQ(iterated, (std::vector<std::string_view>{"alpha", "", "beta", "gamma"}));
+    static_assert(std::is_same_v<std::iterator_traits<TokenTable::iterator>::iterator_category, std::input_iterator_tag>);
+}
+
+TEST(TokenTable, TokensAreContiguous) {
+    TokenTable table;
+    separateInto("ab,cd,ef", ',', table);
+    EXPECT_EQ(table[1].data(), table[0].data() + 2);
+    EXPECT_EQ(table[2].data(), table[1].data() + 2);
+}
+
+TEST(TokenTable, ConvertsToVector) {
+    TokenTable table;
+    table.push_back("x");
+    table.push_back("yz");
+    std::vector<std::string> vec = table;
+    EXPECT_EQ(vec, (std::vector<std::string>{"x", "yz"}));
+}
+
+TEST(TokenTable, ClearKeepsTable_Reusable) {
+    TokenTable table;
+    separateInto("a,b,c", ',', table);
+    table.clear();
+    EXPECT_TRUE(table.empty());
+    separateInto("d,e", ',', table);
+    EXPECT_EQ(table.toVector(), (std::vector<std::string>{"d", "e"}));
+}
+
+// ============================================================================
+// TESTS - splitView()
+// ============================================================================
+
+TEST(SplitView, YieldsViewsIntoSource) {
+    std::string input = "John,Gina,Sebastian";
+    std::vector<std::string_view> pieces;
+    for (std::string_view piece : splitView(input, ',')) {
+        pieces.push_back(piece);
+    }
+    ASSERT_EQ(pieces.size(), 3);
+    EXPECT_EQ(pieces[1], "Gina");
+    EXPECT_EQ(pieces[1].data(), input.data() + 5);  // No copy - points into input
+}
+
+TEST(SplitView, MatchesSeparate_CharSeparator) {
+    for (std::string input : {"a,b,c", "a,,c", ",a,", ",,,", "", "no-separator", ","}) {
+        for (bool omit : {true, false}) {
+            EXPECT_EQ(splitView(input, ',', omit).toVector(), separate(input, ',', omit))
+                << "input='" << input << "', omit=" << omit;
+        }
+    }
+}
+
+TEST(SplitView, MatchesSeparate_StringSeparator) {
+    for (std::string input : {"Wakko and Yakko and Dot", " and a and ", " and  and ", "", "x", "a andand b"}) {
+        for (std::string sep : {" and ", "and", ","}) {
+            for (bool omit : {true, false}) {
+                EXPECT_EQ(splitView(input, sep, omit).toVector(), separate(input, sep, omit))
+                    << "input='" << input << "', sep='" << sep << "', omit=" << omit;
+            }
+        }
+    }
+}
+
+TEST(SplitView, EmptySeparator_SplitsIntoWholeCodepoints) {
+    std::vector<std::string> expected = {"a", "б", "c"};
+    EXPECT_EQ(splitView("aбc", "").toVector(), expected);
+    EXPECT_TRUE(splitView("", "").toVector().empty());
+}
+
+TEST(SplitView, Copy_StillUsesItsOwnSeparator) {
+    SplitView original = splitView("a;b;c", ';');
+    SplitView copy = original;
+    std::vector<std::string> expected = {"a", "b", "c"};
+    EXPECT_EQ(copy.toVector(), expected);
+}
+
+TEST(Separate, Searcher_MatchesStringSeparator) {
+    std::string str = "Wakko and Yakko and  and Dot and ";
+    for (std::string separator : {" and ", "and", "  ", "o", ""}) {
+        for (bool omit : {true, false}) {
+            EXPECT_EQ(separate(str, Searcher(separator), omit), separate(str, separator, omit)) << separator;
+        }
+    }
+}
+
+// ============================================================================
+// TESTS - separateN()
+// ============================================================================
+
+static std::vector<std::string> toStrings(const std::vector<std::string_view>& views) {
+    return std::vector<std::string>(views.begin(), views.end());
+}
+
+TEST(SeparateN, FromLeft_StopsAfterMaxPieces) {
+    SeparateNResult result = separateN("2024-05-01 12:00:00 INFO server started", ' ', 2);
+    std::vector<std::string> expected = {"2024-05-01", "12:00:00"};
+    EXPECT_EQ(toStrings(result.pieces), expected);
+    EXPECT_EQ(result.remainder, "INFO server started");
+}
+
+TEST(SeparateN, FromRight_StopsAfterMaxPieces) {
+    SeparateNResult result = separateN("/usr/local/bin/tool", '/', 2, "right");
+    std::vector<std::string> expected = {"bin", "tool"};
+    EXPECT_EQ(toStrings(result.pieces), expected);
+    EXPECT_EQ(result.remainder, "/usr/local");
+}
+
+TEST(SeparateN, StringSeparator) {
+    SeparateNResult left = separateN("a and b and c and d", " and ", 1);
+    EXPECT_EQ(toStrings(left.pieces), std::vector<std::string>{"a"});
+    EXPECT_EQ(left.remainder, "b and c and d");
+
+    SeparateNResult right = separateN("a and b and c and d", " and ", 2, "right");
+    std::vector<std::string> expected = {"c", "d"};
+    EXPECT_EQ(toStrings(right.pieces), expected);
+    EXPECT_EQ(right.remainder, "a and b");
+}
+
+TEST(SeparateN, RemainderIsAViewIntoSource) {
+    const std::string line = "key=value=more";
+    SeparateNResult result = separateN(line, '=', 1);
+    EXPECT_EQ(result.remainder.data(), line.data() + 4);
+}
+
+TEST(SeparateN, ZeroPieces_RemainderIsWholeString) {
+    SeparateNResult result = separateN("a,b", ',', 0);
+    EXPECT_TRUE(result.pieces.empty());
+    EXPECT_EQ(result.remainder, "a,b");
+}
+
+TEST(SeparateN, EnoughPieces_MatchesSeparate) {
+    std::mt19937 rng(21);
+    for (int trial = 0; trial < 200; ++trial) {
+        std::string input;
+        size_t length = rng() % 40;
+        for (size_t i = 0; i < length; ++i) input += "ab,:"[rng() % 4];
+        for (bool omit : {true, false}) {
+            for (const std::string startFrom : {"left", "right"}) {
+                SeparateNResult byChar = separateN(input, ',', 1000, startFrom, omit);
+                EXPECT_EQ(toStrings(byChar.pieces), separate(input, ',', omit)) << input;
+                EXPECT_TRUE(byChar.remainder.empty());
+            }
+            SeparateNResult byString = separateN(input, "::", 1000, "left", omit);
+            EXPECT_EQ(toStrings(byString.pieces), separate(input, "::", omit)) << input;
+        }
+    }
+}
+
+TEST(SeparateN, PiecesPlusRemainderRebuildInput) {
+    // 7 pieces in total - with fewer requested, there's always a remainder after the last one
+    std::string input = ",a,,b,c,,";
+    for (size_t maxPieces = 0; maxPieces < 7; ++maxPieces) {
+        SeparateNResult left = separateN(input, ',', maxPieces, "left", false);
+        std::vector<std::string> rebuilt = toStrings(left.pieces);
+        rebuilt.push_back(std::string(left.remainder));
+        EXPECT_EQ(join(rebuilt, ",", false), input) << maxPieces;
+    }
+}
+
+TEST(SeparateN, InvalidArguments_Throw) {
+    EXPECT_THROW(separateN("a,b", ',', 1, "middle"), std::invalid_argument);
+    EXPECT_THROW(separateN("a,b", std::string_view(""), 1), std::invalid_argument);
+}
+
+// ============================================================================
+// TESTS - separate() with ParallelSettings
+// ============================================================================
+
+// A tiny minChunkSize forces even short inputs through the chunked path
+static const ParallelSettings kForceChunks = {4, 8};
+
+TEST(SeparateParallel, CharSeparator_MatchesSerial) {
+    std::mt19937 rng(7);
+    for (int trial = 0; trial < 200; ++trial) {
+        std::string input;
+        size_t length = rng() % 300;
+        for (size_t i = 0; i < length; ++i) input += "ab,,c"[rng() % 5];
+        for (bool omit : {true, false}) {
+            EXPECT_EQ(separate(input, ',', omit, kForceChunks), separate(input, ',', omit)) << input;
+        }
+    }
+}
+
+TEST(SeparateParallel, SelfOverlappingSeparator_MatchesSerial) {
+    std::mt19937 rng(11);
+    for (const std::string separator : {"::", "aa", "aba", "xyz"}) {
+        for (int trial = 0; trial < 200; ++trial) {
+            std::string input;
+            size_t length = rng() % 300;
+            for (size_t i = 0; i < length; ++i) input += ":abxyz"[rng() % 6];
+            for (bool omit : {true, false}) {
+                EXPECT_EQ(separate(input, separator, omit, kForceChunks), separate(input, separator, omit))
+                    << separator << " in " << input;
+            }
+        }
+    }
+}
+
+TEST(SeparateParallel, NoSeparatorPresent_ReturnsWholeString) {
+    std::string input(100, 'x');
+    std::vector<std::string> expected = {input};
+    EXPECT_EQ(separate(input, ',', true, kForceChunks), expected);
+}
+
+TEST(SeparateParallel, EmptyInputAndEmptySeparator_MatchSerial) {
+    EXPECT_TRUE(separate("", ',', false, kForceChunks).empty());
+    EXPECT_EQ(separate("héllo wörld", "", true, kForceChunks), separate("héllo wörld", ""));
+}
+
+TEST(SeparateParallel, DefaultSettings_SmallInputRunsSerially) {
+    std::vector<std::string> expected = {"a", "b", "c"};
+    EXPECT_EQ(separate("a,b,c", ',', true, ParallelSettings{}), expected);
+}
+
+// ============================================================================
+// TESTS - forEachCsvRecord() / parseCsv()
+// ============================================================================
+
+TEST(Csv, SimpleRecords) {
+    std::vector<std::vector<std::string>> expected = {{"a", "b", "c"}, {"1", "2", "3"}};
+    EXPECT_EQ(parseCsv("a,b,c\n1,2,3\n"), expected);
+    EXPECT_EQ(parseCsv("a,b,c\n1,2,3"), expected);
+    EXPECT_EQ(parseCsv("a,b,c\r\n1,2,3\r\n"), expected);
+}
+
+TEST(Csv, QuotedDelimitersQuotesAndNewlines) {
+    std::vector<std::vector<std::string>> expected = {
+        {"John", "Hi, \"Gina\"", "line one\nline two"},
+        {"", "x", ""}
+    };
+    EXPECT_EQ(parseCsv("John,\"Hi, \"\"Gina\"\"\",\"line one\nline two\"\n,x,\"\"\n"), expected);
+}
+
+TEST(Csv, EmptyInputAndBlankLines) {
+    EXPECT_TRUE(parseCsv("").empty());
+    std::vector<std::vector<std::string>> expected = {{"a"}, {"b"}};
+    EXPECT_EQ(parseCsv("a\n\n\r\nb\n\n"), expected);
+    std::vector<std::vector<std::string>> quotedEmpty = {{""}};
+    EXPECT_EQ(parseCsv("\"\"\n"), quotedEmpty);
+}
+
+TEST(Csv, CustomDelimiter) {
+    std::vector<std::vector<std::string>> expected = {{"a", "b,c", "d;e"}};
+    EXPECT_EQ(parseCsv("a;b,c;\"d;e\"", ';'), expected);
+}
+
+TEST(Csv, FieldsAreViewsIntoSource) {
+    const std::string csv = "name,\"quo\"\"te\"\n";
+    size_t records = 0;
+    forEachCsvRecord(csv, [&](const std::vector<CsvField>& record) {
+        ++records;
+        ASSERT_EQ(record.size(), 2u);
+        EXPECT_EQ(record[0].raw.data(), csv.data());
+        EXPECT_FALSE(record[0].quoted);
+        EXPECT_EQ(record[1].raw, "quo\"\"te");
+        EXPECT_TRUE(record[1].quoted);
+        EXPECT_EQ(record[1].unescaped(), "quo\"te");
+    });
+    EXPECT_EQ(records, 1u);
+}
+
+TEST(Csv, MalformedQuotedFieldsAreKeptAndFlagged) {
+    EXPECT_EQ(parseCsv("\"a\"b,c\n"), (std::vector<std::vector<std::string>>{{"ab", "c"}}));
+    EXPECT_EQ(parseCsv("\"abc,d\n"), (std::vector<std::vector<std::string>>{{"abc,d\n"}}));
+    EXPECT_EQ(parseCsv("\"x\"\"y\"z\n"), (std::vector<std::vector<std::string>>{{"x\"yz"}}));
+
+    std::vector<bool> malformed;
+    forEachCsvRecord("\"a\"b,\"ok\",c\n", [&](const std::vector<CsvField>& record) {
+        for (const CsvField& field : record) malformed.push_back(field.malformed);
+    });
+    EXPECT_EQ(malformed, (std::vector<bool>{true, false, false}));
+    forEachCsvRecord("x,\"abc,d\n", [&](const std::vector<CsvField>& record) {
+        ASSERT_EQ(record.size(), 2u);
+        EXPECT_TRUE(record[1].malformed);
+        EXPECT_EQ(record[1].raw, "abc,d\n");
+    });
+}
+
+TEST(Csv, MatchesReferenceAcrossBlockBoundaries) {
+    std::mt19937 rng(5);
+    for (int trial = 0; trial < 300; ++trial) {
+        // Build well-formed CSV from random fields, some quoted, so records straddle 64-byte blocks
+        std::vector<std::vector<std::string>> expected;
+        std::string csv;
+        size_t recordCount = 1 + rng() % 6;
+        for (size_t r = 0; r < recordCount; ++r) {
+            std::vector<std::string> record;
+            size_t fieldCount = 1 + rng() % 8;
+            for (size_t f = 0; f < fieldCount; ++f) {
+                std::string value;
+                size_t length = rng() % 20;
+                for (size_t i = 0; i < length; ++i) value += "ab,\"\n x"[rng() % 7];
+                bool needsQuotes = value.find_first_of(",\"\n") != std::string::npos || value.empty();
+                if (needsQuotes) {
+                    csv += "\"" + replaceSubstr(value, "\"", "\"\"") + "\"";
+                } else {
+                    csv += value;
+                }
+                if (f + 1 < fieldCount) csv += ",";
+                record.push_back(value);
+            }
+            csv += (rng() % 2) ? "\r\n" : "\n";
+            expected.push_back(record);
+        }
+        EXPECT_EQ(parseCsv(csv), expected) << csv;
+    }
+}
+
+// ============================================================================
+// TESTS - forEachToken() (streaming)
+// ============================================================================
+
+template <typename Separator>
+static std::vector<std::string> streamTokens(const std::string& input, Separator separator, bool omit,
+                                             size_t bufferSize) {
+    std::istringstream stream(input);
+    std::vector<std::string> tokens;
+    forEachToken(stream, separator, [&](std::string_view token) { tokens.emplace_back(token); }, omit, bufferSize);
+    return tokens;
+}
+
+TEST(ForEachToken, Stream_BasicLines) {
+    std::vector<std::string> expected = {"first", "second", "third"};
+    EXPECT_EQ(streamTokens("first\nsecond\nthird\n", '\n', true, 1 << 16), expected);
+}
+
+TEST(ForEachToken, Stream_TokensStraddlingRefills_MatchSeparate) {
+    std::mt19937 rng(3);
+    for (int trial = 0; trial < 300; ++trial) {
+        std::string input;
+        size_t length = 1 + rng() % 200;
+        for (size_t i = 0; i < length; ++i) input += "ab,:"[rng() % 4];
+        size_t bufferSize = 1 + rng() % 16;
+        for (bool omit : {true, false}) {
+            EXPECT_EQ(streamTokens(input, ',', omit, bufferSize), separate(input, ',', omit)) << input;
+            EXPECT_EQ(streamTokens(input, std::string_view("::"), omit, bufferSize), separate(input, "::", omit))
+                << input;
+            EXPECT_EQ(streamTokens(input, std::string_view("a,b"), omit, bufferSize), separate(input, "a,b", omit))
+                << input;
+        }
+    }
+}
+
+TEST(ForEachToken, Stream_TokenLongerThanBuffer) {
+    std::string longToken(1000, 'x');
+    std::vector<std::string> expected = {"a", longToken, "b"};
+    EXPECT_EQ(streamTokens("a," + longToken + ",b", ',', true, 8), expected);
+}
+
+TEST(ForEachToken, Stream_TokensHandedOutBeforeMoreInputArrives) {
+    // Serves one chunk per refill, like a pipe delivering lines as they're written
+    class ChunkedBuffer : public std::streambuf {
+    public:
+        explicit ChunkedBuffer(std::vector<std::string> chunks) : m_chunks(std::move(chunks)) {}
+        size_t refills = 0;
+    protected:
+        int_type underflow() override {
+            if (refills == m_chunks.size()) return traits_type::eof();
+            std::string& chunk = m_chunks[refills++];
+            setg(chunk.data(), chunk.data(), chunk.data() + chunk.size());
+            return traits_type::to_int_type(chunk[0]);
+        }
+    private:
+        std::vector<std::string> m_chunks;
+    };
+
+    for (bool substringSeparator : {false, true}) {
+        ChunkedBuffer buffer({"alpha\n", "be", "ta\n", "gamma"});
+        std::istream input(&buffer);
+        std::vector<std::pair<std::string, size_t>> seen;
+        auto visitor = [&](std::string_view token) { seen.emplace_back(token, buffer.refills); };
+        if (substringSeparator) {
+            forEachToken(input, std::string_view("\n"), visitor);
+        } else {
+            forEachToken(input, '\n', visitor);
+        }
+        EXPECT_EQ(seen, (std::vector<std::pair<std::string, size_t>>{{"alpha", 1}, {"beta", 3}, {"gamma", 4}}));
+    }
+}
+
+TEST(ForEachToken, Stream_EmptyInputAndEmptySeparator) {
+    EXPECT_TRUE(streamTokens("", ',', false, 16).empty());
+    std::istringstream stream("abc");
+    EXPECT_THROW(forEachToken(stream, std::string_view(""), [](std::string_view) {}), std::invalid_argument);
+}
+
+#if defined(STEVENSSTRINGLIB_POSIX_IO)
+TEST(ForEachToken, FileDescriptor_MatchesSeparate) {
+    const std::string input = "alpha;;beta;gamma;" + std::string(300, 'z') + ";delta";
+    FILE* file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    std::fputs(input.c_str(), file);
+    std::fflush(file);
+
+    for (bool omit : {true, false}) {
+        std::rewind(file);
+        std::vector<std::string> tokens;
+        forEachToken(fileno(file), ';', [&](std::string_view token) { tokens.emplace_back(token); }, omit, 32);
+        EXPECT_EQ(tokens, separate(input, ';', omit));
+    }
+    std::fclose(file);
+}
+#endif
+
 // ============================================================================
 // TESTS - join()
 // ============================================================================
@@ -129,6 +819,138 @@ TEST(Join, WithEmptyStrings_OmitFalse) {
     EXPECT_EQ(result, "apple, , cherry");
 }
 
+TEST(Join, GenericRanges) {
+    std::vector<std::string_view> views = {"apple", "", "cherry"};
+    EXPECT_EQ(join(views, "|"), "apple|cherry");
+    EXPECT_EQ(join(views, "|", false), "apple||cherry");
+
+    const char* cstrings[] = {"a", "b", "c"};
+    EXPECT_EQ(join(cstrings, "-"), "a-b-c");
+    EXPECT_EQ(join(std::begin(cstrings) + 1, std::end(cstrings), "-"), "b-c");
+
+    std::list<std::string> list = {"x", "y"};
+    EXPECT_EQ(join(list, std::string(", ")), "x, y");
+    EXPECT_EQ(join({"first", "", "last"}, " "), "first last");
+    EXPECT_EQ(join(std::vector<std::string>{"", ""}, ","), "");
+    EXPECT_EQ(join(std::vector<std::string>{"", ""}, ",", false), ",");
+}
+
+TEST(Join, ParallelMatchesSerial) {
+    std::mt19937 rng(59);
+    for (int trial = 0; trial < 30; ++trial) {
+        std::vector<std::string> tokens(rng() % 300);
+        for (std::string& token : tokens) {
+            // Mostly short tokens, with runs of empties so whole chunks can be empty
+            if (rng() % 3 != 0) token = std::to_string(rng() % 100000);
+        }
+        if (trial % 5 == 0) std::fill(tokens.begin(), tokens.begin() + tokens.size() / 2, "");
+        const std::string separator = (trial % 2 == 0) ? "," : " :: ";
+        for (bool omitEmptyStrings : {true, false}) {
+            const ParallelSettings settings{static_cast<unsigned int>(1 + rng() % 8), 16};
+            EXPECT_EQ(join(tokens, separator, omitEmptyStrings, settings), join(tokens, separator, omitEmptyStrings))
+                << "trial " << trial << " omitEmptyStrings " << omitEmptyStrings;
+        }
+    }
+
+    std::list<std::string> notRandomAccess = {"a", "", "b"};
+    EXPECT_EQ(join(notRandomAccess, "+", false, ParallelSettings{4, 1}), "a++b");
+    std::vector<std::string_view> views(1000, "xy");
+    EXPECT_EQ(join(views, "", true, ParallelSettings{3, 1}), multiply("xy", 1000));
+}
+
+TEST(Join, IntoSinks) {
+    std::vector<std::string_view> fields = {"id", "", "name"};
+
+    std::string body = "fields=";
+    joinInto(fields, ",", body);
+    joinInto(fields, ",", body, false);
+    EXPECT_EQ(body, "fields=id,nameid,,name");
+    EXPECT_EQ(joinedLength(fields, ","), 7u);
+    EXPECT_EQ(joinedLength(fields, ",", false), 8u);
+
+    char buffer[7];
+    auto result = joinInto(fields, ",", buffer, buffer + sizeof(buffer));
+    EXPECT_EQ(result.ec, std::errc());
+    EXPECT_EQ(std::string(buffer, result.ptr), "id,name");
+    result = joinInto(fields, ",", buffer, buffer + sizeof(buffer), false);
+    EXPECT_EQ(result.ec, std::errc::value_too_large);
+    EXPECT_EQ(result.ptr, buffer + sizeof(buffer));
+
+    std::ostringstream stream;
+    joinInto(fields, " | ", std::ostreambuf_iterator<char>(stream));
+    EXPECT_EQ(stream.str(), "id | name");
+}
+
+template <typename Range, typename Separator, typename = void>
+struct CanJoinView : std::false_type {};
+
+template <typename Range, typename Separator>
+struct CanJoinView<Range, Separator, std::void_t<decltype(joinView(std::declval<Range>(), std::declval<Separator>()))>>
+    : std::true_type {};
+
+TEST(JoinView, RejectsTemporaries) {
+    using Tokens = std::vector<std::string>;
+    static_assert(CanJoinView<const Tokens&, const char (&)[2]>::value);
+    static_assert(CanJoinView<Tokens&, std::string&>::value);
+    static_assert(CanJoinView<const Tokens&, const std::string&>::value);
+    static_assert(CanJoinView<const Tokens&, std::string_view>::value);
+    static_assert(!CanJoinView<Tokens, const char (&)[2]>::value);
+    static_assert(!CanJoinView<const Tokens, const char (&)[2]>::value);
+    static_assert(!CanJoinView<const Tokens&, std::string>::value);
+    static_assert(!CanJoinView<const Tokens&, const std::string>::value);
+}
+
+TEST(JoinView, ChunksConcatenateToJoin) {
+    std::mt19937 rng(61);
+    for (int trial = 0; trial < 40; ++trial) {
+        std::vector<std::string> tokens(rng() % 12);
+        for (std::string& token : tokens) {
+            if (rng() % 3 != 0) token = std::string(1 + rng() % 4, "abc"[rng() % 3]);
+        }
+        for (std::string separator : {"", ",", " | "}) {
+            for (bool omitEmptyStrings : {true, false}) {
+                const auto view = joinView(tokens, separator, omitEmptyStrings);
+                const std::string expected = join(tokens, separator, omitEmptyStrings);
+                std::string concatenated;
+                for (std::string_view chunk : view) {
+                    EXPECT_FALSE(chunk.empty());
+                    concatenated += chunk;
+                }
+                EXPECT_EQ(concatenated, expected);
+                EXPECT_EQ(view.size(), expected.size());
+                EXPECT_EQ(view.str(), expected);
+            }
+        }
+    }
+
+    const char* cstrings[] = {"a", "", "b"};
+    EXPECT_EQ(std::vector<std::string_view>(joinView(cstrings, "--", false).begin(), joinView(cstrings, "--", false).end()),
+              (std::vector<std::string_view>{"a", "--", "--", "b"}));
+    std::ostringstream stream;
+    stream << joinView(cstrings, ", ") << '!';
+    EXPECT_EQ(stream.str(), "a, b!");
+}
+
+#if defined(STEVENSSTRINGLIB_POSIX_IO)
+TEST(JoinView, WriteToFileDescriptor) {
+    // More chunks than fit in one writev() batch
+    std::vector<std::string> tokens;
+    for (int i = 0; i < 500; ++i) tokens.push_back(std::to_string(i));
+    FILE* file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    joinView(tokens, ",").writeTo(fileno(file));
+
+    std::rewind(file);
+    std::string written;
+    char buffer[256];
+    for (size_t bytesRead; (bytesRead = std::fread(buffer, 1, sizeof(buffer), file)) > 0;) {
+        written.append(buffer, bytesRead);
+    }
+    std::fclose(file);
+    EXPECT_EQ(written, join(tokens, ","));
+}
+#endif
+
 // Property: separate then join should give back original (roundtrip)
 TEST(JoinSeparate, RoundtripProperty) {
     std::string original = "apple,banana,cherry,date";
@@ -242,6 +1064,15 @@ TEST(TrimWhitespace, OnlyWhitespace_ReturnsEmpty) {
     EXPECT_EQ(trimWhitespace("   \t\n\r   "), "");
 }
 
+TEST(Trim_CharSet, TrimsMembersFromBothEnds) {
+    const CharSet quotesAndSpaces("\"' ");
+    EXPECT_EQ(trim(" \"hello world\" ", quotesAndSpaces), "hello world");
+    EXPECT_EQ(trim("data", quotesAndSpaces), "data");
+    EXPECT_EQ(trim("  ''  ", quotesAndSpaces), "");
+    EXPECT_EQ(trim("", quotesAndSpaces), "");
+    EXPECT_EQ(trim(std::string(40, ' ') + "x y" + std::string(40, ' '), quotesAndSpaces), "x y");
+}
+
 TEST(Trim, BasicTrimFromBothEnds) {
     EXPECT_EQ(trim("Hello, world!", 1), "ello, world");
 }
@@ -331,6 +1162,49 @@ TEST(Multiply, LengthProperty) {
     EXPECT_EQ(result.length(), str.length() * n);
 }
 
+TEST(Multiply, IntoStringBuilder) {
+    StringBuilder builder;
+    builder.append('[');
+    multiply("ab", 3, builder);
+    multiply("zz", -2, builder);
+    builder.append(']');
+    EXPECT_EQ(builder.view(), "[ababab]");
+}
+
+// ============================================================================
+// TESTS - StringBuilder
+// ============================================================================
+
+TEST(StringBuilder, AppendsPiecesAndNumbers) {
+    StringBuilder builder;
+    EXPECT_TRUE(builder.empty());
+    builder.append("id=").appendNumber(42).append(',').append(std::string("n=")).appendNumber(-7LL);
+    builder.append(',').appendNumber(0.5).append(',').appendNumber(1e100).append(',').appendNumber(255u);
+    builder.append(3, '-');
+    EXPECT_EQ(builder.str(), "id=42,n=-7,0.5,1e+100,255---");
+    EXPECT_EQ(builder.length(), builder.view().length());
+
+    double roundTrip = std::stod(StringBuilder().appendNumber(0.1 + 0.2).str());
+    EXPECT_EQ(roundTrip, 0.1 + 0.2);
+}
+
+TEST(StringBuilder, GrowsAcrossManyAppends) {
+    StringBuilder builder;
+    std::string expected;
+    for (int i = 0; i < 10000; ++i) {
+        builder.appendNumber(i).append(' ');
+        expected += std::to_string(i) + " ";
+    }
+    EXPECT_GE(builder.capacity(), builder.length());
+    EXPECT_EQ(builder.str(), expected);
+
+    builder.clear();
+    EXPECT_TRUE(builder.empty());
+    builder.append("reused");
+    EXPECT_EQ(std::move(builder).str(), "reused");
+    EXPECT_TRUE(builder.empty());
+}
+
 // ============================================================================
 // TESTS - Scramble
 // ============================================================================
@@ -470,6 +1344,15 @@ TEST(WrapToWidth, FirstLineWidthDefaultsToWrapWidth) {
     EXPECT_EQ(wrapToWidth(str, 9), wrapToWidth(str, 9, 9));
 }
 
+TEST(WrapToWidth, IntoStringBuilderMatchesStringVersion) {
+    for (std::string str : {"the quick brown fox\n\njumps over\n", "no newline at end", "\n\n", "世界世界世界 abc"}) {
+        StringBuilder builder;
+        builder.append(">");
+        wrapToWidth(str, 6, builder, 2);
+        EXPECT_EQ(builder.str(), ">" + wrapToWidth(str, 6, 2)) << str;
+    }
+}
+
 // ============================================================================
 // TESTS - countLines()
 // ============================================================================
@@ -2,10 +2,16 @@
  * @file string_searching_test.cpp
  * @brief Unit tests for string searching and matching functions
  *
- * Tests for: contains, containsOnly, startsWith, endsWith, findAll
+ * Tests for: contains, containsOnly, startsWith, endsWith, findAll, forEachOccurrence, countAll,
+ *            containsIgnoreCase, startsWithIgnoreCase, endsWithIgnoreCase, findAllIgnoreCase,
+ *            findFirstOf, findFirstNotOf, findLastOf, findLastNotOf, containsWhich, whichContain,
+ *            Searcher, MultiPatternMatcher, findAll overlap policy and ParallelSettings, SubstringIndex,
+ *            SuffixArray, FMIndex
  */
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
 #include "../../stevensStringLib.h"
 #include "../fixtures/test_data.h"
 
@@ -112,6 +118,47 @@ TEST(ContainsOnly, NumericString) {
     EXPECT_FALSE(containsOnly("11101112222", "12"));  // Contains '0'
 }
 
+// ============================================================================
+// TESTS - containsOnly(), contains() and findFirstOf() etc. with a CharSet
+// ============================================================================
+
+TEST(ContainsOnly_CharSet, MatchesStringVariant) {
+    const CharSet hexDigits("0123456789abcdefABCDEF");
+    EXPECT_TRUE(containsOnly("deadBEEF", hexDigits));
+    EXPECT_FALSE(containsOnly("0x1f", hexDigits));
+    EXPECT_TRUE(containsOnly("", hexDigits));
+    EXPECT_TRUE(containsOnly("", CharSet()));
+    EXPECT_FALSE(containsOnly("a", CharSet()));
+    std::string longHex(100, 'f');
+    EXPECT_TRUE(containsOnly(longHex, hexDigits));
+    longHex[70] = 'g';
+    EXPECT_FALSE(containsOnly(longHex, hexDigits));
+}
+
+TEST(Contains_CharSet, AnyMember) {
+    EXPECT_TRUE(contains("hello world", CharSet(" \t")));
+    EXPECT_FALSE(contains("helloworld", CharSet(" \t")));
+    EXPECT_FALSE(contains("", CharSet("a")));
+}
+
+TEST(FindFirstOf_CharSet, MatchesStdString) {
+    std::mt19937 rng(31);
+    for (int trial = 0; trial < 300; ++trial) {
+        std::string str, chars;
+        size_t length = rng() % 120, charCount = rng() % 4;
+        for (size_t i = 0; i < length; ++i) str += "ab_\xE9"[rng() % 4];
+        for (size_t i = 0; i < charCount; ++i) chars += "ab_\xE9"[rng() % 4];
+        const CharSet set(chars);
+        for (size_t pos : {size_t(0), size_t(1), length / 2, length, std::string::npos}) {
+            size_t from = std::min(pos, length);
+            EXPECT_EQ(findFirstOf(str, set, from), str.find_first_of(chars, from)) << str << " / " << chars;
+            EXPECT_EQ(findFirstNotOf(str, set, from), str.find_first_not_of(chars, from)) << str << " / " << chars;
+            EXPECT_EQ(findLastOf(str, set, pos), str.find_last_of(chars, pos)) << str << " / " << chars;
+            EXPECT_EQ(findLastNotOf(str, set, pos), str.find_last_not_of(chars, pos)) << str << " / " << chars;
+        }
+    }
+}
+
 // ============================================================================
 // TESTS - startsWith()
 // ============================================================================
@@ -192,6 +239,47 @@ TEST(EndsWith, LongSentence) {
     EXPECT_FALSE(endsWith(sentence, "lazy cat"));
 }
 
+// ============================================================================
+// TESTS - containsIgnoreCase(), startsWithIgnoreCase(), endsWithIgnoreCase(),
+// findAllIgnoreCase()
+// ============================================================================
+
+TEST(IgnoreCase, MatchesToLowerCopies) {
+    std::mt19937 rng(41);
+    for (int trial = 0; trial < 300; ++trial) {
+        std::string str, substr;
+        size_t length = rng() % 80, substrLength = rng() % 5;
+        for (size_t i = 0; i < length; ++i) str += "aAbB-"[rng() % 5];
+        for (size_t i = 0; i < substrLength; ++i) substr += "aAbB-"[rng() % 5];
+        std::string lowerStr = toLower(str), lowerSubstr = toLower(substr);
+        EXPECT_EQ(containsIgnoreCase(str, substr), contains(lowerStr, lowerSubstr)) << str << " / " << substr;
+        EXPECT_EQ(startsWithIgnoreCase(str, substr), startsWith(lowerStr, lowerSubstr)) << str << " / " << substr;
+        EXPECT_EQ(endsWithIgnoreCase(str, substr), endsWith(lowerStr, lowerSubstr)) << str << " / " << substr;
+        EXPECT_EQ(findAllIgnoreCase(str, substr), findAll(lowerStr, lowerSubstr)) << str << " / " << substr;
+    }
+}
+
+TEST(IgnoreCase, HeaderMatching) {
+    EXPECT_TRUE(containsIgnoreCase("Content-Type: text/HTML; charset=UTF-8", "text/html"));
+    EXPECT_TRUE(startsWithIgnoreCase("CONTENT-LENGTH: 42", "content-length"));
+    EXPECT_TRUE(endsWithIgnoreCase("keep-alive, Upgrade", "UPGRADE"));
+    EXPECT_FALSE(startsWithIgnoreCase("Con", "content"));
+    EXPECT_FALSE(endsWithIgnoreCase("", "a"));
+    EXPECT_TRUE(endsWithIgnoreCase("abc", ""));
+}
+
+TEST(IgnoreCase, Utf8Fallback) {
+    EXPECT_TRUE(containsIgnoreCase("Grüße aus MÜNCHEN", "münchen"));
+    EXPECT_TRUE(startsWithIgnoreCase("ÄPFEL und Birnen", "äpfel"));
+    EXPECT_TRUE(endsWithIgnoreCase("ΑΛΦΑ", "αλφα"));
+    EXPECT_FALSE(endsWithIgnoreCase("ΑΛΦΑ", "β"));
+    EXPECT_EQ(findAllIgnoreCase("éÉxé", "é"), (std::vector<size_t>{0, 2, 5}));
+    // KELVIN SIGN (3 bytes) lowercases to 'k' (1 byte)
+    EXPECT_TRUE(endsWithIgnoreCase("\u212A", "k"));
+    EXPECT_TRUE(startsWithIgnoreCase("\u212Aey", "KEY"));
+    EXPECT_EQ(findAllIgnoreCase("a\u212Ak", "k"), (std::vector<size_t>{1, 4}));
+}
+
 // ============================================================================
 // TESTS - findAll() string variant
 // ============================================================================
@@ -264,6 +352,350 @@ TEST(FindAll_Char, BinaryString) {
     }
 }
 
+// ============================================================================
+// TESTS - forEachOccurrence() and countAll()
+// ============================================================================
+
+TEST(ForEachOccurrence, Char_VisitsSamePositionsAsFindAll) {
+    std::string str = std::string(40, 'x') + "a,b,c" + std::string(40, ',');
+    std::vector<size_t> visited;
+    EXPECT_TRUE(forEachOccurrence(str, ',', [&](size_t index) { visited.push_back(index); }));
+    EXPECT_EQ(visited, findAll(str, ','));
+}
+
+TEST(ForEachOccurrence, StopsEarlyWhenVisitorReturnsFalse) {
+    std::vector<size_t> firstTwo;
+    bool completed = forEachOccurrence("a,b,c,d", ',', [&](size_t index) {
+        firstTwo.push_back(index);
+        return firstTwo.size() < 2;
+    });
+    EXPECT_FALSE(completed);
+    EXPECT_EQ(firstTwo, (std::vector<size_t>{1, 3}));
+
+    size_t visits = 0;
+    EXPECT_FALSE(forEachOccurrence("aaaa", "aa", [&](size_t) { return ++visits < 1; }));
+    EXPECT_EQ(visits, 1u);
+}
+
+TEST(ForEachOccurrence, Substring_OverlapsLikeFindAll) {
+    std::vector<size_t> visited;
+    forEachOccurrence("aaaa", "aa", [&](size_t index) { visited.push_back(index); });
+    EXPECT_EQ(visited, findAll("aaaa", "aa"));
+
+    std::vector<size_t> bySearcher;
+    forEachOccurrence("aaaa", Searcher("aa"), [&](size_t index) { bySearcher.push_back(index); });
+    EXPECT_EQ(bySearcher, visited);
+}
+
+TEST(CountAll, MatchesFindAllSize) {
+    std::mt19937 rng(13);
+    for (int trial = 0; trial < 200; ++trial) {
+        std::string str;
+        size_t length = rng() % 150;
+        for (size_t i = 0; i < length; ++i) str += "ab,"[rng() % 3];
+        EXPECT_EQ(countAll(str, ','), findAll(str, ',').size());
+        EXPECT_EQ(countAll(str, "ab"), findAll(str, "ab").size());
+        EXPECT_EQ(countAll(str, ","), findAll(str, ",").size());
+        EXPECT_EQ(countAll(str, Searcher("a,")), findAll(str, "a,").size());
+    }
+    EXPECT_EQ(countAll("", 'a'), 0u);
+    EXPECT_EQ(countAll("abc", ""), 4u);
+}
+
+// ============================================================================
+// TESTS - Searcher, and contains()/findAll() with a Searcher
+// ============================================================================
+
+TEST(Searcher, FindMatchesStdFind) {
+    std::mt19937 rng(9);
+    for (int trial = 0; trial < 500; ++trial) {
+        std::string haystack, needle;
+        size_t haystackLength = rng() % 120, needleLength = rng() % 6;
+        for (size_t i = 0; i < haystackLength; ++i) haystack += "ab a"[rng() % 4];
+        for (size_t i = 0; i < needleLength; ++i) needle += "ab a"[rng() % 4];
+        Searcher searcher(needle);
+        for (size_t from : {size_t(0), size_t(1), haystackLength / 2, haystackLength, haystackLength + 1}) {
+            EXPECT_EQ(searcher.find(haystack, from), std::string_view(haystack).find(needle, from))
+                << "needle '" << needle << "' in '" << haystack << "' from " << from;
+        }
+    }
+}
+
+TEST(Searcher, MatchAtVeryEndOfLongHaystack) {
+    std::string haystack = std::string(100, 'x') + "::";
+    EXPECT_EQ(Searcher("::").find(haystack), 100u);
+    EXPECT_EQ(Searcher("x::").find(haystack), 99u);
+    EXPECT_EQ(Searcher(":::").find(haystack), std::string::npos);
+}
+
+TEST(Contains_Searcher, MatchesSubstringVariant) {
+    Searcher world("world");
+    EXPECT_TRUE(contains("hello world", world));
+    EXPECT_FALSE(contains("hello word", world));
+    EXPECT_FALSE(contains("", world));
+}
+
+TEST(FindAll_Searcher, MatchesSubstringVariant) {
+    std::string str = "aaaa and bbb and and c";
+    for (std::string needle : {"and", "aa", " and ", "a", "zz"}) {
+        EXPECT_EQ(findAll(str, Searcher(needle)), findAll(str, needle)) << needle;
+    }
+}
+
+// ============================================================================
+// TESTS - findAll() overlap policy, and findAll() with ParallelSettings
+// ============================================================================
+
+TEST(FindAll_Overlapping, NonOverlappingResumesAfterEachOccurrence) {
+    EXPECT_EQ(findAll("aaaaa", "aa", true), (std::vector<size_t>{0, 1, 2, 3}));
+    EXPECT_EQ(findAll("aaaaa", "aa", false), (std::vector<size_t>{0, 2}));
+    EXPECT_EQ(findAll("aaaaa", Searcher("aa"), false), (std::vector<size_t>{0, 2}));
+    EXPECT_EQ(findAll("abab", "", false), (std::vector<size_t>{0, 1, 2, 3, 4}));
+    EXPECT_EQ(findAll("abab", "ab", true), findAll("abab", "ab"));
+}
+
+TEST(FindAll_Parallel, MatchesSerialFindAll) {
+    static const ParallelSettings forceChunks = {4, 8};
+    std::mt19937 rng(29);
+    for (int trial = 0; trial < 300; ++trial) {
+        std::string str, needle;
+        size_t length = rng() % 200, needleLength = 1 + rng() % 4;
+        for (size_t i = 0; i < length; ++i) str += "aab"[rng() % 3];
+        for (size_t i = 0; i < needleLength; ++i) needle += "aab"[rng() % 3];
+        for (bool overlapping : {true, false}) {
+            EXPECT_EQ(findAll(str, needle, overlapping, forceChunks), findAll(str, needle, overlapping))
+                << "needle '" << needle << "' in '" << str << "' overlapping " << overlapping;
+        }
+    }
+    EXPECT_EQ(findAll(std::string(100, 'a'), "aaa", false, forceChunks).size(), 33u);
+    EXPECT_EQ(findAll("a,b,c", ",", true, ParallelSettings{}), (std::vector<size_t>{1, 3}));
+}
+
+// ============================================================================
+// TESTS - MultiPatternMatcher, and findAll()/forEachOccurrence() with one
+// ============================================================================
+
+static std::vector<std::pair<size_t, size_t>> toPairs(const std::vector<PatternMatch>& matches) {
+    std::vector<std::pair<size_t, size_t>> pairs;
+    for (const PatternMatch& match : matches) pairs.emplace_back(match.patternId, match.offset);
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+}
+
+TEST(MultiPatternMatcher, FindsEveryPatternInOnePass) {
+    MultiPatternMatcher keywords({"error", "timeout", "out"});
+    std::vector<PatternMatch> hits = findAll("timeout error", keywords);
+    std::vector<std::pair<size_t, size_t>> expected = {{0, 8}, {1, 0}, {2, 4}};
+    EXPECT_EQ(toPairs(hits), expected);
+    EXPECT_EQ(keywords.patternCount(), 3u);
+}
+
+TEST(MultiPatternMatcher, MatchesFindAllPerPattern) {
+    std::mt19937 rng(23);
+    for (int trial = 0; trial < 100; ++trial) {
+        std::vector<std::string> patterns;
+        for (size_t p = 0; p < 1 + rng() % 8; ++p) {
+            std::string pattern;
+            for (size_t i = 0; i < 1 + rng() % 4; ++i) pattern += "abc"[rng() % 3];
+            patterns.push_back(pattern);
+        }
+        std::string text;
+        for (size_t i = 0; i < rng() % 200; ++i) text += "abcd"[rng() % 4];
+
+        std::vector<std::pair<size_t, size_t>> expected;
+        for (size_t id = 0; id < patterns.size(); ++id) {
+            for (size_t offset : findAll(text, patterns[id])) expected.emplace_back(id, offset);
+        }
+        std::sort(expected.begin(), expected.end());
+        EXPECT_EQ(toPairs(findAll(text, MultiPatternMatcher(patterns))), expected) << text;
+    }
+}
+
+TEST(MultiPatternMatcher, CaseInsensitive) {
+    MultiPatternMatcher matcher({"Error", "WARN"}, true);
+    std::vector<std::pair<size_t, size_t>> expected = {{0, 0}, {0, 11}, {1, 6}};
+    EXPECT_EQ(toPairs(findAll("ERROR warn error", matcher)), expected);
+    EXPECT_TRUE(findAll("ERROR", MultiPatternMatcher({"error"})).empty());
+}
+
+TEST(MultiPatternMatcher, EmptyPatternsNeverMatch) {
+    MultiPatternMatcher matcher({"", "a"});
+    std::vector<std::pair<size_t, size_t>> expected = {{1, 0}, {1, 2}};
+    EXPECT_EQ(toPairs(findAll("aba", matcher)), expected);
+    EXPECT_TRUE(findAll("", matcher).empty());
+}
+
+TEST(MultiPatternMatcher, ForEachOccurrence_StopsEarly) {
+    MultiPatternMatcher matcher({"a"});
+    size_t visits = 0;
+    EXPECT_FALSE(forEachOccurrence("aaaa", matcher, [&](const PatternMatch&) { return ++visits < 2; }));
+    EXPECT_EQ(visits, 2u);
+}
+
+// ============================================================================
+// TESTS - batch contains(): containsWhich() and whichContain()
+// ============================================================================
+
+TEST(ContainsWhich, MatchesContainsPerNeedle) {
+    const MultiPatternMatcher keywords({"error", "timeout", "disk", "", "out"});
+    std::vector<bool> expected = {false, true, false, true, true};
+    EXPECT_EQ(containsWhich("timeout while writing", keywords), expected);
+    EXPECT_TRUE(contains("timeout while writing", keywords));
+
+    std::mt19937 rng(37);
+    for (int trial = 0; trial < 100; ++trial) {
+        std::vector<std::string> needles;
+        for (size_t n = 0; n < 1 + rng() % 6; ++n) {
+            std::string needle;
+            for (size_t i = 0; i < 1 + rng() % 3; ++i) needle += "abc"[rng() % 3];
+            needles.push_back(needle);
+        }
+        std::string haystack;
+        for (size_t i = 0; i < rng() % 30; ++i) haystack += "abcd"[rng() % 4];
+        const MultiPatternMatcher matcher(needles);
+        std::vector<bool> found = containsWhich(haystack, matcher);
+        bool any = false;
+        for (size_t n = 0; n < needles.size(); ++n) {
+            EXPECT_EQ(found[n], contains(haystack, needles[n])) << needles[n] << " in " << haystack;
+            any = any || found[n];
+        }
+        EXPECT_EQ(contains(haystack, matcher), any);
+    }
+}
+
+TEST(WhichContain, ReturnsIndicesOfMatchingHaystacks) {
+    std::vector<std::string> rows = {"disk full", "ok", "disk slow", ""};
+    EXPECT_EQ(whichContain(rows, Searcher("disk")), (std::vector<size_t>{0, 2}));
+    EXPECT_EQ(whichContain(rows, "ok"), (std::vector<size_t>{1}));
+    EXPECT_EQ(whichContain(rows, ""), (std::vector<size_t>{0, 1, 2, 3}));
+
+    std::vector<std::string_view> views = {"a full disk", "fine", "slow"};
+    EXPECT_EQ(whichContain(views, MultiPatternMatcher({"full", "slow"})), (std::vector<size_t>{0, 2}));
+    const char* cstrings[] = {"x", "yx", "y"};
+    EXPECT_EQ(whichContain(cstrings, "x"), (std::vector<size_t>{0, 1}));
+}
+
+// ============================================================================
+// TESTS - SubstringIndex
+// ============================================================================
+
+TEST(SubstringIndex, MatchesFindAllOnRandomText) {
+    std::mt19937 rng(43);
+    for (int trial = 0; trial < 50; ++trial) {
+        std::string text;
+        size_t length = rng() % 600;
+        for (size_t i = 0; i < length; ++i) text += "abca"[rng() % 4];
+        const SubstringIndex index(text, 1 + rng() % 16);
+        for (int query = 0; query < 20; ++query) {
+            std::string needle;
+            for (size_t i = 0, needleLength = rng() % 7; i < needleLength; ++i) needle += "abc"[rng() % 3];
+            EXPECT_EQ(index.findAll(needle), findAll(text, needle)) << "needle '" << needle << "'";
+            EXPECT_EQ(index.contains(needle), contains(text, needle)) << "needle '" << needle << "'";
+        }
+    }
+}
+
+TEST(SubstringIndex, ParallelBuildMatchesSerial) {
+    std::string text;
+    for (int i = 0; i < 2000; ++i) text += "row " + std::to_string(i * 7919 % 1000) + ";";
+    const SubstringIndex serial(text, 64);
+    const SubstringIndex parallel(text, ParallelSettings{4, 64}, 64);
+    EXPECT_GT(parallel.memoryUsage(), 0u);
+    for (std::string needle : {"row 1", "99;", "row 999;", ";row", "nope", "7", ""}) {
+        EXPECT_EQ(parallel.findAll(needle), serial.findAll(needle)) << needle;
+        EXPECT_EQ(serial.findAll(needle), findAll(text, needle)) << needle;
+        EXPECT_EQ(serial.countAll(needle), countAll(text, needle)) << needle;
+    }
+}
+
+TEST(SubstringIndex, Frankenstein) {
+    class LocalFixture : public TestData::LargeTextFixture {};
+    LocalFixture::SetUpTestSuite();
+    const std::string& text = LocalFixture::getFrankenstein();
+
+    const SubstringIndex index(text);
+    EXPECT_TRUE(index.contains("conflagration"));
+    EXPECT_FALSE(index.contains("zzzzzznonexistent"));
+    EXPECT_EQ(index.findAll("Elizabeth"), findAll(text, "Elizabeth"));
+    EXPECT_EQ(index.countAll("the"), countAll(text, "the"));
+    EXPECT_THROW(SubstringIndex(text, 0), std::invalid_argument);
+}
+
+// ============================================================================
+// TESTS - SuffixArray and FMIndex
+// ============================================================================
+
+TEST(SuffixArray, MatchesNaiveSort) {
+    std::mt19937 rng(47);
+    std::vector<std::string> texts = {"", "a", "banana", "mississippi", std::string(300, 'a')};
+    std::string periodic;
+    for (int i = 0; i < 150; ++i) periodic += "ab";
+    texts.push_back(periodic);
+    for (int trial = 0; trial < 40; ++trial) {
+        std::string text;
+        const char* alphabet = (trial % 2 == 0) ? "ab" : "abcd\xff";
+        size_t alphabetSize = std::strlen(alphabet);
+        for (size_t i = 0, length = rng() % 500; i < length; ++i) text += alphabet[rng() % alphabetSize];
+        texts.push_back(text);
+    }
+    for (const std::string& text : texts) {
+        std::vector<int32_t> expected(text.size());
+        for (size_t i = 0; i < text.size(); ++i) expected[i] = static_cast<int32_t>(i);
+        std::sort(expected.begin(), expected.end(), [&](int32_t a, int32_t b) {
+            return std::string_view(text).substr(a) < std::string_view(text).substr(b);
+        });
+        EXPECT_EQ(SuffixArray(text).suffixes(), expected) << "text '" << text << "'";
+    }
+}
+
+TEST(SuffixArray, MatchesFindAllOnRandomText) {
+    std::mt19937 rng(53);
+    for (int trial = 0; trial < 50; ++trial) {
+        std::string text;
+        for (size_t i = 0, length = rng() % 600; i < length; ++i) text += "abca"[rng() % 4];
+        const SuffixArray suffixArray(text);
+        const FMIndex index(text, 1 + rng() % 40);
+        for (int query = 0; query < 20; ++query) {
+            std::string needle;
+            for (size_t i = 0, needleLength = rng() % 7; i < needleLength; ++i) needle += "abc"[rng() % 3];
+            const std::vector<size_t> expected = findAll(text, needle);
+            EXPECT_EQ(suffixArray.findAll(needle), expected) << "needle '" << needle << "'";
+            EXPECT_EQ(suffixArray.countAll(needle), expected.size()) << "needle '" << needle << "'";
+            EXPECT_EQ(index.findAll(needle), expected) << "needle '" << needle << "'";
+            EXPECT_EQ(index.countAll(needle), expected.size()) << "needle '" << needle << "'";
+            EXPECT_EQ(index.contains(needle), contains(text, needle)) << "needle '" << needle << "'";
+        }
+    }
+}
+
+TEST(FMIndex, HandlesNulAndHighBytes) {
+    const std::string text("a\0b\0\0\xff\xfe\0a\0b", 11);
+    const FMIndex index(text, 3);
+    EXPECT_EQ(index.length(), text.size());
+    EXPECT_EQ(index.sampleRate(), 3u);
+    for (std::string needle : {std::string("\0", 1), std::string("\0\0", 2), std::string("a\0b", 3),
+                               std::string("\xff\xfe"), std::string("b"), std::string("\xfe\xff")}) {
+        EXPECT_EQ(index.findAll(needle), findAll(text, needle));
+    }
+    EXPECT_THROW(FMIndex(text, 0), std::invalid_argument);
+}
+
+TEST(FMIndex, Frankenstein) {
+    class LocalFixture : public TestData::LargeTextFixture {};
+    LocalFixture::SetUpTestSuite();
+    const std::string& text = LocalFixture::getFrankenstein();
+
+    const SuffixArray suffixArray(text);
+    const FMIndex index(suffixArray);
+    EXPECT_EQ(index.sampleRate(), 32u);
+    EXPECT_TRUE(index.contains("conflagration"));
+    EXPECT_FALSE(index.contains("zzzzzznonexistent"));
+    EXPECT_EQ(suffixArray.findAll("Elizabeth"), findAll(text, "Elizabeth"));
+    EXPECT_EQ(index.findAll("Elizabeth"), findAll(text, "Elizabeth"));
+    EXPECT_EQ(index.countAll("the"), countAll(text, "the"));
+    EXPECT_LT(index.memoryUsage(), text.size() * 3 / 2);
+}
+
 // ============================================================================
 // PROPERTY-BASED TESTS
 // ============================================================================